@@ -0,0 +1,53 @@
+// include/AnimationClip.h
+#ifndef ANIMATION_CLIP_H
+#define ANIMATION_CLIP_H
+
+#include "TextureLibrary.h"
+#include <cstdint>
+#include <vector>
+
+// 动画的播放方式
+enum class AnimationLoop : uint8_t
+{
+    LOOP, // 循环播放
+    ONCE, // 播放一遍后停在最后一帧
+    PING_PONG // 正放到最后一帧再倒放回第一帧，如此往复
+};
+
+// 动画片段：帧序列、每帧持续时间和播放方式
+// 片段不保存播放进度，任意时刻的帧都由播放时间直接算出
+struct AnimationClip
+{
+    TextureGroup frames; // 帧序列
+    float frameDuration = 0.1f; // 每帧持续时间
+    AnimationLoop loop = AnimationLoop::LOOP; // 播放方式
+
+    // 播放了 time 秒时的帧下标
+    int FrameAt(float time) const;
+    // 播放了 time 秒时的纹理，没有帧时返回无效句柄
+    TextureHandle Sample(float time) const;
+};
+
+// 动画片段句柄：片段库中的下标
+using AnimationClipId = int;
+constexpr AnimationClipId INVALID_CLIP = -1;
+
+// 全局动画片段库：实体只保存片段句柄和相位偏移，当前帧由全局动画时钟加相位算出，不需要逐帧推进
+// 加载资源时 (模拟线程启动前) 注册，之后只读，可在任意线程取样
+class AnimationLibrary
+{
+public:
+    // 注册一个片段
+    static AnimationClipId Add(const AnimationClip& clip);
+    // 通过句柄获取片段，无效句柄返回空片段
+    static const AnimationClip& Get(AnimationClipId id);
+    // 片段播放了 time 秒时的纹理
+    static TextureHandle Sample(const AnimationClipId id, const float time) { return Get(id).Sample(time); }
+    // 删除所有片段 (重新加载资源前调用)
+    static void Clear();
+
+private:
+    static std::vector<AnimationClip> clips; // 所有片段
+};
+
+#endif // ANIMATION_CLIP_H
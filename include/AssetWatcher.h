@@ -0,0 +1,66 @@
+// include/AssetWatcher.h
+#ifndef ASSET_WATCHER_H
+#define ASSET_WATCHER_H
+
+#include "raylib.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 被修改的资源类型
+enum class AssetKind
+{
+    TEXTURE, // 纹理 (.png)
+    SOUND // 音效 (.wav)
+};
+
+// 后台线程重新加载好的资源，等待在帧边界替换
+struct ReloadedAsset
+{
+    std::string path; // 与加载时相同的路径 (如 assets/images/bird_1.png)
+    AssetKind kind; // 资源类型
+    Image image; // 新的图片 (TEXTURE)，由接收方卸载
+    Wave wave; // 新的设备格式波形 (SOUND)，由接收方卸载
+};
+
+// 资源目录监视器：用 inotify 阻塞等待文件写入，只在后台线程重新解码被修改的文件
+// 没有修改时主线程只读一个原子标志；非 Linux 平台上 Start 返回 false，热重载不可用
+class AssetWatcher
+{
+public:
+    AssetWatcher();
+    ~AssetWatcher();
+
+    // 开始监视目录及其子目录 (音效需要在音频设备初始化之后)
+    bool Start(const char* rootDirectory);
+    // 停止并等待监视线程
+    void Stop();
+
+    // 是否有等待替换的资源 (主线程每帧调用，只读原子标志)
+    bool HasPending() const { return hasPending.load(std::memory_order_acquire); }
+    // 取出所有等待替换的资源
+    std::vector<ReloadedAsset> TakePending();
+
+private:
+    int inotifyFd; // inotify 描述符
+    int wakeFd; // 用来唤醒监视线程退出的 eventfd
+    std::unordered_map<int, std::string> watchedDirectories; // 监视号 -> 目录路径
+    std::thread watchThread; // 监视线程
+    std::mutex pendingMutex; // 保护 pending
+    std::vector<ReloadedAsset> pending; // 等待替换的资源
+    std::atomic<bool> hasPending; // pending 是否非空
+
+    // 监视线程主循环
+    void WatchLoop();
+    // 监视目录及其所有子目录
+    void AddWatches(const std::string& directory);
+    // 重新解码被修改的文件并放入 pending
+    void ReloadFile(const std::string& path);
+    // 释放一个资源的图片或波形
+    static void Release(ReloadedAsset& asset);
+};
+
+#endif // ASSET_WATCHER_H
@@ -0,0 +1,143 @@
+// include/AudioSystem.h
+#ifndef AUDIO_SYSTEM_H
+#define AUDIO_SYSTEM_H
+
+#include "raylib.h"
+#include "SpscQueue.h"
+#include "StreamingMusic.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 音效句柄：音频系统中的下标，实体只保存句柄而不保存 Sound
+using SoundHandle = int;
+constexpr SoundHandle INVALID_SOUND = -1;
+
+// 音频命令类型
+enum class AudioCommandType : uint8_t
+{
+    PLAY_SOUND, // 播放音效
+    PLAY_MUSIC, // 开始 (或继续) 播放背景音乐
+    PAUSE_MUSIC, // 暂停背景音乐
+    RESUME_MUSIC, // 恢复背景音乐
+    STOP_MUSIC // 停止背景音乐并回到开头
+};
+
+// 模拟线程发给音频线程的一条命令
+struct AudioCommand
+{
+    AudioCommandType type; // 命令类型
+    SoundHandle sound; // 音效句柄 (只有 PLAY_SOUND 使用)
+    uint32_t tick; // 发出命令的模拟步序号，同一步内叠加的相同音效会逐个降低音量
+};
+
+// 音效的发声设置
+struct SoundSettings
+{
+    int priority = 0; // 优先级，发声数用完时低优先级的声音先被抢占
+    int maxVoices = 1; // 同一音效最多同时发声的数量，超过时重新开始其中最早的一个
+    float volume = 1.0f; // 音量
+};
+
+// 音频系统：统一持有音效和背景音乐，所有 raylib 音频调用都在独立的音频线程中执行
+// 游戏逻辑只把命令放进单生产者队列，不会被音频工作阻塞
+// 每个音效按 maxVoices 预先创建共享采样数据的别名作为发声，同时发声的总数受发声预算限制
+class AudioSystem
+{
+public:
+    static constexpr size_t COMMAND_QUEUE_SIZE = 256; // 命令队列容量
+    static constexpr int UPDATE_INTERVAL_MS = 5; // 音频线程处理命令和填充音乐流的间隔
+    static constexpr int DEFAULT_VOICE_BUDGET = 8; // 默认的同时发声总数
+
+    // 加载音效 (主线程，音频线程启动前调用)，经过设备格式的磁盘缓存，加载失败时也会占用一个句柄
+    static SoundHandle LoadSound(const char* path, const SoundSettings& settings = {});
+    // 加载 QOA 背景音乐流及其循环区间 (主线程，音频线程启动前调用)
+    static bool LoadMusic(const char* path, float volume);
+    // 启动音频线程
+    static void Start();
+    // 停止并等待音频线程
+    static void Stop();
+    // 卸载所有音效和音乐 (音频线程停止后调用)
+    static void UnloadAll();
+    // 设置同时发声的总数 (音频线程启动前调用)
+    static void SetVoiceBudget(int voices);
+    // 用新的设备格式波形替换从 path 加载的音效，句柄不变 (任意线程，由音频线程在下一轮替换并卸载波形)
+    static void QueueReload(const std::string& path, const Wave& wave);
+
+    // 以下函数只能由同一个线程 (模拟线程) 调用
+    // 开始新的一步：之后发出的音效属于这一步
+    static void BeginTick();
+    // 播放音效 (队列满时丢弃)
+    static void Play(SoundHandle sound);
+    // 开始 (或继续) 播放背景音乐
+    static void PlayMusic();
+    // 暂停背景音乐
+    static void PauseMusic();
+    // 恢复背景音乐
+    static void ResumeMusic();
+    // 停止背景音乐并回到开头
+    static void StopMusic();
+
+    // 因队列满被丢弃的命令数
+    static uint32_t GetDroppedCommandCount() { return droppedCommands.load(std::memory_order_relaxed); }
+    // 被抢占的发声数
+    static uint32_t GetStolenVoiceCount() { return stolenVoices.load(std::memory_order_relaxed); }
+    // 因发声预算用完且优先级不够而没有播放的音效数
+    static uint32_t GetRejectedVoiceCount() { return rejectedVoices.load(std::memory_order_relaxed); }
+
+private:
+    // 一个发声：音效本身或它的别名
+    struct Voice
+    {
+        Sound sound; // 发声使用的 Sound
+        bool alias; // 是否为别名 (卸载方式不同)
+        uint64_t startOrder; // 开始播放的序号，用来找最早的发声
+    };
+
+    // 一个音效及它的发声
+    struct SoundEntry
+    {
+        std::string path; // 文件路径 (热重载时查找)
+        SoundSettings settings; // 发声设置
+        int firstVoice; // 第一个发声在 voices 中的下标
+        int voiceCount; // 发声数
+        uint32_t lastTick; // 最近一次播放所在的模拟步
+        int playsInTick; // 这一步内已经播放的次数
+    };
+
+    static std::vector<SoundEntry> sounds; // 所有音效
+    static std::vector<Voice> voices; // 所有发声，同一音效的发声相邻 (音频线程使用)
+    static int voiceBudget; // 同时发声的总数
+    static uint64_t nextStartOrder; // 下一个开始播放的序号 (音频线程使用)
+    static StreamingMusic music; // 背景音乐
+    static SpscQueue<AudioCommand, COMMAND_QUEUE_SIZE> commands; // 模拟线程 -> 音频线程
+    static std::thread audioThread; // 音频线程
+    static std::atomic<bool> running; // 音频线程是否运行
+    static std::atomic<uint32_t> droppedCommands; // 因队列满被丢弃的命令数
+    static std::atomic<uint32_t> stolenVoices; // 被抢占的发声数
+    static std::atomic<uint32_t> rejectedVoices; // 没有拿到发声的音效数
+    static std::mutex reloadMutex; // 保护 pendingReloads
+    static std::vector<std::pair<std::string, Wave>> pendingReloads; // 等待替换的音效
+    static std::atomic<bool> reloadPending; // pendingReloads 是否非空
+    static uint32_t currentTick; // 当前模拟步序号 (生产者线程使用)
+
+    // 放入一条命令
+    static void Push(AudioCommandType type, SoundHandle sound);
+    // 音频线程主循环
+    static void AudioLoop();
+    // 执行一条命令
+    static void Execute(const AudioCommand& command);
+    // 为音效选一个发声，必要时抢占；没有可用的发声时返回 -1
+    static int AcquireVoice(SoundHandle sound);
+    // 为音效创建发声：第一个使用音效本身，其余是共享采样数据的别名
+    static void CreateVoices(SoundEntry& entry, const Sound& source);
+    // 卸载音效的所有发声
+    static void DestroyVoices(const SoundEntry& entry);
+    // 替换等待中的音效 (音频线程)
+    static void ApplyReloads();
+};
+
+#endif // AUDIO_SYSTEM_H
@@ -0,0 +1,37 @@
+// include/CacheAlignedAllocator.h
+#ifndef CACHE_ALIGNED_ALLOCATOR_H
+#define CACHE_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+constexpr size_t CACHE_LINE_SIZE = 64; // 缓存行大小
+
+// 按缓存行对齐分配的分配器：按缓存行整数倍切分的数组块互不共享缓存行，多个线程分块写入时不会伪共享
+template <typename T>
+struct CacheAlignedAllocator
+{
+    using value_type = T;
+
+    CacheAlignedAllocator() = default;
+
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&)
+    {
+    }
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(CACHE_LINE_SIZE)));
+    }
+
+    void deallocate(T* pointer, size_t)
+    {
+        ::operator delete(pointer, std::align_val_t(CACHE_LINE_SIZE));
+    }
+
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U>&) const { return true; }
+};
+
+#endif // CACHE_ALIGNED_ALLOCATOR_H
@@ -7,6 +7,24 @@
 #include <iostream>
 #include <cmath>
 #include "ParticleSystem.h"
+#include "TextureLibrary.h"
+#include "AnimationClip.h"
+#include "Snapshot.h"
+#include "RenderCommandList.h"
+#include "AudioSystem.h"
+
+// 恐龙的运动参数，通关验证器使用同一份参数模拟恐龙
+struct DinoMovementModel
+{
+    float gravity = 1800.0f; // 重力加速度
+    float jumpSpeed = -600.0f; // 跳跃初速度
+    float sneakGravityMultiplier = 2.5f; // 潜行时重力倍增器
+    float moveSpeed = 280.0f; // 移动速度
+    float dashSpeedMagnitude = 800.0f; // 冲刺速度大小
+    float dashDuration = 0.18f; // 冲刺持续时间
+    float dashCooldown = 0.5f; // 冲刺冷却时间
+    float groundTolerance = 5.0f; // 判定为着地的容差 (也是站立时陷入地面的深度)
+};
 
 // 表示玩家控制的恐龙角色
 class Dinosaur
@@ -20,18 +38,18 @@ public:
 
     // 构造函数
     Dinosaur(float startX, float groundY,
-             const std::vector<Texture2D>& runTex,
-             const std::vector<Texture2D>& sneakTex,
-             const Texture2D& deadTex,
-             const Sound& jumpSound,
-             const Sound& dashSound);
+             AnimationClipId runClip,
+             AnimationClipId sneakClip,
+             TextureHandle deadTex,
+             SoundHandle jumpSound,
+             SoundHandle dashSound);
     // 析构函数
     ~Dinosaur();
 
-    // 更新恐龙状态
-    void Update(float deltaTime, float worldScrollSpeed);
-    // 绘制恐龙
-    void Draw() const;
+    // 更新恐龙状态，冲刺拖尾粒子发射到 dashTrail 并一起更新
+    void Update(float deltaTime, float worldScrollSpeed, ParticleSystem& dashTrail);
+    // 绘制恐龙，动画帧按全局动画时钟 animationTime 取样
+    void Draw(RenderCommandList& commands, float animationTime) const;
 
     // 请求跳跃
     void RequestJump();
@@ -63,49 +81,48 @@ public:
 
     // 更新碰撞矩形
     void UpdateCollisionRect();
+    // 获取运动参数
+    const DinoMovementModel& GetMovementModel() const { return movement; }
+    // 把身体矩形缩减为实际用于碰撞检测的矩形
+    static Rectangle ShrinkCollisionRect(Rectangle bodyRect, bool sneaking, bool dashing);
+
+    // 将恐龙的物理和计时器状态写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复恐龙状态
+    void LoadState(SnapshotReader& reader);
 
 private:
-    Sound jumpSoundHandle; // 跳跃音效句柄
-    Sound dashSoundHandle; // 冲刺音效句柄
+    SoundHandle jumpSoundHandle; // 跳跃音效句柄
+    SoundHandle dashSoundHandle; // 冲刺音效句柄
     bool isJumping; // 跳跃状态标志
     bool isSneaking; // 潜行状态标志
     bool facingRight; // 朝向标志 (true为右)
 
-    std::vector<Texture2D> runFrames; // 奔跑动画帧
-    std::vector<Texture2D> sneakFrames; // 潜行动画帧
-    Texture2D deadTexture; // 死亡状态纹理
+    AnimationClipId runClip; // 奔跑动画片段
+    AnimationClipId sneakClip; // 潜行动画片段
+    TextureHandle deadTexture; // 死亡状态纹理
     bool isDead; // 死亡状态标志
-    int currentAnimFrameIndex; // 当前动画帧索引
-    float frameTimeCounter; // 动画帧计时器
-    float animationSpeed; // 动画播放速度
 
     Rectangle collisionRect; // 碰撞矩形
 
-    float gravity; // 重力加速度
-    float jumpSpeed; // 跳跃初速度
     float jumpBufferDuration; // 跳跃缓冲持续时长
     float jumpBufferCounter; // 跳跃缓冲计时器
     bool jumpQueued; // 是否已缓存跳跃请求
-    float sneakGravityMultiplier; // 潜行时重力倍增器
-    float moveSpeed; // 移动速度
+    DinoMovementModel movement; // 运动参数
 
     bool isDashing; // 是否正在冲刺
-    float dashSpeedMagnitude; // 冲刺速度大小
-    float dashDuration; // 冲刺持续时间
     float dashTimer; // 冲刺计时器
-    float dashCooldown; // 冲刺冷却时间
     float dashCooldownTimer; // 冲刺冷却计时器
     Vector2 dashDirection; // 冲刺方向
 
-    ParticleSystem dashTrailParticles; // 冲刺拖尾粒子效果
-    ParticleProperties dashParticleProps; // 冲刺拖尾粒子属性
+    ParticleProperties dashParticleProps; // 冲刺拖尾粒子属性 (粒子池由调用者持有)
 
     // 执行跳跃动作
     void ExecuteJump();
-    // 获取当前动画帧组的指针
-    const std::vector<Texture2D>* GetCurrentAnimationFramesPointer() const;
-    // 获取当前要绘制的纹理
-    Texture2D GetCurrentTextureToDraw() const;
+    // 获取当前状态的动画片段
+    const AnimationClip& GetCurrentClip() const;
+    // 获取全局动画时钟为 animationTime 时应该绘制的纹理句柄
+    TextureHandle GetCurrentTextureHandle(float animationTime) const;
 };
 
 #endif // DINOSAUR_H
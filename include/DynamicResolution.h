@@ -0,0 +1,70 @@
+// include/DynamicResolution.h
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include "raylib.h"
+#include <array>
+
+// 动态分辨率参数
+struct DynamicResolutionSettings
+{
+    float frameBudget = 1.0f / 160.0f; // 每帧预算 (秒)
+    float overloadRatio = 1.2f; // 平滑帧时间超过预算的这个倍数视为超载
+    float headroomRatio = 1.05f; // 平滑帧时间低于预算的这个倍数视为有余量
+    float smoothing = 0.1f; // 帧时间指数平滑系数
+    int overloadFrames = 30; // 连续超载多少帧后降低分辨率
+    float probeInterval = 2.0f; // 有余量持续多久后尝试升高一级 (秒)
+    float maxProbeInterval = 16.0f; // 升级失败后等待间隔翻倍的上限 (秒)
+};
+
+// 动态内部分辨率：按帧时间在几个固定缩放级别之间切换
+// 每个级别预先创建一张渲染纹理，切换时不会重新分配显存
+class DynamicResolution
+{
+public:
+    static constexpr std::array<float, 3> SCALE_LEVELS = {1.0f, 0.75f, 0.5f}; // 相对虚拟分辨率的缩放级别
+
+    DynamicResolution();
+
+    // 为每个缩放级别创建渲染纹理 (窗口创建后调用)
+    void Initialize(int virtualWidth, int virtualHeight, const DynamicResolutionSettings& newSettings);
+    // 释放渲染纹理
+    void Unload();
+    // 启用或关闭动态分辨率，关闭时固定使用原始分辨率
+    void SetEnabled(bool enabled);
+    // 设置每帧预算 (秒)
+    void SetFrameBudget(float seconds);
+    // 报告上一帧的时间，返回缩放级别是否改变
+    bool ReportFrameTime(float seconds);
+
+    // 当前缩放级别下标 (0 为原始分辨率)
+    int GetLevel() const { return level; }
+    // 当前缩放比例
+    float GetScale() const { return SCALE_LEVELS[level]; }
+    // 当前级别的渲染纹理
+    const RenderTexture2D& GetTarget() const { return targets[level]; }
+    // 当前级别渲染纹理的源矩形 (渲染纹理上下颠倒)
+    Rectangle GetSourceRect() const;
+    // 把虚拟坐标映射到当前渲染纹理的摄像机
+    Camera2D GetCamera() const;
+    // 平滑后的帧时间 (秒)
+    float GetSmoothedFrameTime() const { return smoothedFrameTime; }
+
+private:
+    DynamicResolutionSettings settings; // 参数
+    std::array<RenderTexture2D, SCALE_LEVELS.size()> targets; // 各级别的渲染纹理
+    int virtualWidth; // 虚拟屏幕宽度
+    int level; // 当前级别
+    bool enabled; // 是否启用
+    float smoothedFrameTime; // 平滑后的帧时间
+    int overloadCount; // 连续超载的帧数
+    float headroomTime; // 连续有余量的时间
+    float currentProbeInterval; // 当前升级等待间隔
+    float timeSinceProbe; // 上次升级后经过的时间 (升级后很快又超载说明这一级撑不住)
+    bool probing; // 上次级别变化是否为尝试升级
+
+    // 切换到指定级别并重置计数
+    void SetLevel(int newLevel);
+};
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -0,0 +1,25 @@
+// include/EntitySystems.h
+#ifndef ENTITY_SYSTEMS_H
+#define ENTITY_SYSTEMS_H
+
+#include "EntityWorld.h"
+#include "RenderCommandList.h"
+
+// 实体系统：每个系统是对拥有所需组件的原型的一次紧密循环
+// 新的敌人类型只需要注册新的组件组合，不需要新的循环
+namespace EntitySystems
+{
+    // 移动：POSITION + MOVEMENT，按世界滚动速度乘以速度倍数向左移动
+    void Move(EntityWorld& world, float deltaTime, float worldScrollSpeed);
+    // 飞行：POSITION + FLIGHT，按游戏时间直接算出飞行曲线上的位置 (没有逐步累积的状态)
+    void Fly(EntityWorld& world, float time, float scrollAcceleration);
+    // 碰撞矩形：POSITION + SPRITE + COLLIDER，跟随位置和全局动画时钟为 animationTime 时的帧纹理尺寸
+    void UpdateColliders(EntityWorld& world, float animationTime);
+    // 剔除：POSITION + COLLIDER，删除完全移出屏幕左侧的实体
+    void CullOffscreen(EntityWorld& world);
+    // 绘制：POSITION + SPRITE，按全局动画时钟取帧并记录到 layer 层 (只读，可在渲染线程调用)
+    // 动画没有逐帧推进的状态，所以不需要单独的动画系统
+    void Draw(const EntityWorld& world, float animationTime, RenderLayer layer, RenderCommandList& commands);
+}
+
+#endif // ENTITY_SYSTEMS_H
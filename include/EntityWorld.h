@@ -0,0 +1,113 @@
+// include/EntityWorld.h
+#ifndef ENTITY_WORLD_H
+#define ENTITY_WORLD_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include "Snapshot.h"
+#include "FlightPath.h"
+#include "AnimationClip.h"
+#include <cstdint>
+#include <vector>
+
+// 组件位：一个原型由它拥有的组件组合决定
+using ComponentMask = uint32_t;
+namespace Component
+{
+    constexpr ComponentMask POSITION = 1u << 0; // 左上角位置
+    constexpr ComponentMask MOVEMENT = 1u << 1; // 跟随世界滚动向左移动
+    constexpr ComponentMask FLIGHT = 1u << 7; // 位置由出生时确定的飞行曲线按游戏时间算出
+    constexpr ComponentMask SPRITE = 1u << 2; // 纹理帧 (没有 ANIMATION 时画第一帧)
+    constexpr ComponentMask ANIMATION = 1u << 3; // 按全局动画时钟从动画片段取样当前帧
+    constexpr ComponentMask COLLIDER = 1u << 4; // 碰撞矩形 (与当前帧纹理同大小)
+    constexpr ComponentMask LETHAL = 1u << 5; // 标记：碰到恐龙时游戏结束
+    constexpr ComponentMask SLASHABLE = 1u << 6; // 标记：可以被剑击杀
+}
+
+// 原型下标
+using ArchetypeId = int;
+constexpr ArchetypeId INVALID_ARCHETYPE = -1;
+
+// 创建实体时各组件的初值，原型没有的组件被忽略
+struct EntityDesc
+{
+    Vector2 position = {0.0f, 0.0f}; // POSITION
+    float speedFactor = 1.0f; // MOVEMENT：相对世界滚动速度的倍数
+    FlightState flight; // FLIGHT
+    TextureGroup frames; // SPRITE
+    AnimationClipId clip = INVALID_CLIP; // ANIMATION：动画片段
+    float animationPhase = 0.0f; // ANIMATION：相对全局动画时钟的相位偏移
+};
+
+// 一个原型：拥有相同组件组合的实体，每个组件一列 (结构数组)，同一行是同一个实体
+// 没有的组件对应的列保持为空；删除实体时用最后一行填补，各列始终紧密排列
+struct Archetype
+{
+    ComponentMask mask = 0; // 组件组合
+    std::vector<Vector2> positions; // POSITION
+    std::vector<float> speedFactors; // MOVEMENT
+    std::vector<FlightState> flights; // FLIGHT
+    std::vector<TextureGroup> frames; // SPRITE
+    std::vector<AnimationClipId> clips; // ANIMATION
+    std::vector<float> animationPhases; // ANIMATION
+    std::vector<Rectangle> colliders; // COLLIDER
+
+    // 实体数
+    size_t size() const { return positions.size(); }
+    // 是否拥有 required 中的所有组件
+    bool Has(const ComponentMask required) const { return (mask & required) == required; }
+    // 全局动画时钟为 animationTime 时第 row 行的纹理 (需要 SPRITE)
+    TextureHandle FrameAt(size_t row, float animationTime) const;
+};
+
+// 实体世界：按原型保存所有实体，系统按组件组合遍历原型中紧密排列的列
+// 只含 vector，可以整体复制给渲染线程
+class EntityWorld
+{
+public:
+    // 注册一个原型 (加载资源时调用)，组件组合相同时返回已有的原型
+    ArchetypeId RegisterArchetype(ComponentMask mask);
+    // 在原型中创建实体，返回它所在的行
+    size_t Create(ArchetypeId archetype, const EntityDesc& desc);
+    // 删除原型中的一行 (最后一行移到这里，遍历时应从后往前)
+    void Destroy(ArchetypeId archetype, size_t row);
+    // 删除所有实体，保留原型
+    void Clear();
+    // 删除所有原型 (重新加载资源前调用)
+    void Reset();
+
+    // 所有原型
+    std::vector<Archetype>& GetArchetypes() { return archetypes; }
+    const std::vector<Archetype>& GetArchetypes() const { return archetypes; }
+    // 实体总数
+    size_t GetEntityCount() const;
+
+    // 对拥有 required 中所有组件的原型调用 fn(Archetype&)
+    template <typename Fn>
+    void ForEach(const ComponentMask required, Fn&& fn)
+    {
+        for (auto& archetype : archetypes)
+        {
+            if (archetype.Has(required) && archetype.size() > 0) fn(archetype);
+        }
+    }
+
+    template <typename Fn>
+    void ForEach(const ComponentMask required, Fn&& fn) const
+    {
+        for (const auto& archetype : archetypes)
+        {
+            if (archetype.Has(required) && archetype.size() > 0) fn(archetype);
+        }
+    }
+
+    // 写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复，原型与已注册的不一致时返回 false 并清空实体
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    std::vector<Archetype> archetypes; // 已注册的原型
+};
+
+#endif // ENTITY_WORLD_H
@@ -0,0 +1,49 @@
+// include/FlightPath.h
+#ifndef FLIGHT_PATH_H
+#define FLIGHT_PATH_H
+
+#include "raylib.h"
+#include <cstdint>
+
+// 鸟的飞行曲线类型
+enum class FlightProfile : uint8_t
+{
+    CONSTANT, // 匀速平飞
+    SWOOP, // 上下起伏
+    DIVE // 平飞一段后俯冲到更低的高度
+};
+
+// 鸟的飞行曲线：生成时确定，之后不再改变
+// 水平速度是世界滚动速度的固定倍数；高度 (以高度系数表示，0为最高，1为贴近地面) 是飞过的水平距离的函数，
+// 所以按时间和按世界滚动距离都能直接算出位置，不需要逐帧的随机数或积分
+struct FlightPath
+{
+    FlightProfile profile = FlightProfile::CONSTANT; // 曲线类型
+    float speedFactor = 1.4f; // 相对世界滚动速度的倍数
+    float amplitude = 0.0f; // 高度系数的变化量 (SWOOP 为起伏幅度，DIVE 为下降量)
+    float length = 1.0f; // 曲线一段飞过的水平距离 (SWOOP 为一个周期，DIVE 为俯冲过程)
+    float start = 0.0f; // 曲线开始时已飞过的水平距离 (SWOOP 为相位，DIVE 为开始俯冲的位置)
+
+    // 世界滚动 scrolled 距离时鸟飞过的水平距离
+    float FlownDistance(const float scrolled) const { return speedFactor * scrolled; }
+    // 飞过 flown 水平距离时的高度系数 (限制在 0 到 1)
+    float HeightFactorAt(float baseHeight, float flown) const;
+};
+
+// 一只鸟的飞行状态：出生时的参数，位置是游戏时间的闭式函数
+// 世界滚动速度随时间线性增长，所以出生后世界滚动的距离是 v * t + a * t^2 / 2
+struct FlightState
+{
+    FlightPath path; // 飞行曲线
+    float spawnX = 0.0f; // 出生时的左边缘X坐标
+    float spawnTime = 0.0f; // 出生时的游戏时间
+    float spawnScrollSpeed = 0.0f; // 出生时的世界滚动速度
+    float baseHeight = 0.0f; // 出生时的高度系数
+    float highestTop = 0.0f; // 高度系数为0时的顶部Y坐标
+    float lowestTop = 0.0f; // 高度系数为1时的顶部Y坐标
+
+    // 游戏时间为 time、世界滚动速度增长率为 scrollAcceleration 时的左上角位置
+    Vector2 PositionAt(float time, float scrollAcceleration) const;
+};
+
+#endif // FLIGHT_PATH_H
@@ -0,0 +1,81 @@
+// include/FrameGraph.h
+#ifndef FRAME_GRAPH_H
+#define FRAME_GRAPH_H
+
+#include "JobSystem.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+// 任务在哪个线程执行
+enum class JobAffinity
+{
+    ANY, // 任意工作线程 (或帮忙的调用线程)
+    CALLER // 只在调用 Run 的线程上按添加顺序执行 (使用线程局部随机数、GPU 等)
+};
+
+// 一个任务在最近一次运行中的耗时
+struct JobTiming
+{
+    const char* name = ""; // 任务名
+    float start = 0.0f; // 相对 Run 开始的时间 (毫秒)
+    float duration = 0.0f; // 耗时 (毫秒)
+    int worker = -1; // 执行的工作线程，-1 为调用线程
+};
+
+// 每帧的任务依赖图：结构只建立一次，每帧调用 Run 重新执行
+// 没有依赖的任务并行执行，一个任务完成时把依赖都已完成的后继任务交给调度器
+class FrameGraph
+{
+public:
+    using NodeId = int;
+
+    FrameGraph() = default;
+    FrameGraph(const FrameGraph&) = delete;
+    FrameGraph& operator=(const FrameGraph&) = delete;
+
+    // 添加任务 (只能在 Run 之外调用)，dependencies 中的任务都完成后才开始
+    NodeId Add(const char* name, std::function<void()> work, std::initializer_list<NodeId> dependencies = {},
+               JobAffinity affinity = JobAffinity::ANY);
+    // 执行一次整张图并等待完成；调用线程执行 CALLER 任务，其余时间帮忙执行排队的任务
+    void Run(JobSystem& jobs);
+
+    // 最近一次完成的运行中各任务的耗时 (按添加顺序)，运行中的任务也可以读取
+    const std::vector<JobTiming>& GetTimings() const { return timings; }
+    // 最近一次运行的总耗时 (毫秒)
+    float GetLastDuration() const { return lastDuration; }
+    // 任务数
+    int GetNodeCount() const { return static_cast<int>(nodes.size()); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // 一个任务
+    struct Node
+    {
+        const char* name; // 任务名
+        std::function<void()> work; // 任务内容
+        std::vector<NodeId> dependents; // 依赖这个任务的后继任务
+        int dependencyCount; // 前置任务数
+        JobAffinity affinity; // 执行线程
+    };
+
+    std::vector<Node> nodes; // 所有任务
+    std::unique_ptr<std::atomic<int>[]> remaining; // 各任务还没完成的前置任务数 (本次运行)
+    std::atomic<int> unfinished{0}; // 还没完成的任务数 (本次运行)
+    JobSystem* scheduler = nullptr; // 本次运行使用的调度器
+    Clock::time_point runStart; // 本次运行的开始时间
+    std::vector<JobTiming> runTimings; // 本次运行中各任务的耗时 (各任务分别写入)
+    std::vector<JobTiming> timings; // 最近一次完成的运行中各任务的耗时
+    float lastDuration = 0.0f; // 最近一次运行的总耗时
+
+    // 执行一个任务并通知后继
+    void Execute(NodeId node);
+    // 调度器回调
+    static void ExecuteJob(void* context, int index);
+};
+
+#endif // FRAME_GRAPH_H
@@ -0,0 +1,72 @@
+// include/FramePacer.h
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <array>
+#include <chrono>
+
+// 帧节奏模式
+enum class FramePacingMode
+{
+    UNCAPPED, // 不限帧
+    VSYNC, // 垂直同步，由交换缓冲阻塞
+    CAPPED // 固定帧率上限：先睡眠再自旋等到截止时间
+};
+
+// 帧节奏统计 (最近一段时间的帧间隔)
+struct FramePacingStats
+{
+    float averageFrameTime = 0.0f; // 平均帧间隔 (秒)
+    float jitter = 0.0f; // 帧间隔的标准差 (秒)
+    float worstDeviation = 0.0f; // 与平均值相差最大的一帧 (秒)
+    float workTime = 0.0f; // 上一帧除去等待之外的耗时 (秒)
+};
+
+// 主线程帧节奏控制：不再依赖 raylib 的 SetTargetFPS，自己控制每帧的等待并统计抖动
+class FramePacer
+{
+public:
+    static constexpr int HISTORY_SIZE = 120; // 统计抖动使用的帧数
+    static constexpr int DEFAULT_TARGET_FPS = 160; // 默认帧率上限
+
+    FramePacer();
+
+    // 切换模式 (主线程，窗口创建后调用)；targetFps 只在 CAPPED 模式下使用
+    void SetMode(FramePacingMode newMode, int targetFps);
+    // 一帧结束 (EndDrawing 之后) 调用：CAPPED 模式下等到下一帧的开始时间，并记录帧间隔
+    void EndFrame();
+    // 空闲等待之后调用：等待时间不计入下一帧的耗时和帧间隔统计
+    void SkipIdleTime();
+
+    // 当前模式
+    FramePacingMode GetMode() const { return mode; }
+    // 每帧预算 (秒)：CAPPED 为目标帧间隔，VSYNC 为显示器刷新间隔，UNCAPPED 为 CAPPED 模式的目标帧间隔
+    float GetFrameBudget() const;
+    // 最近一段时间的帧节奏统计
+    FramePacingStats GetStats() const;
+    // 上一帧除去等待之外的耗时 (秒)
+    float GetLastWorkTime() const { return lastWorkTime; }
+    // CAPPED 模式的目标帧率
+    int GetTargetFps() const { return targetFps; }
+    // 模式名称
+    static const char* GetModeName(FramePacingMode pacingMode);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacingMode mode; // 当前模式
+    int targetFps; // CAPPED 模式的目标帧率
+    Clock::duration framePeriod; // CAPPED 模式的帧间隔
+    Clock::time_point frameStart; // 本帧开始时间
+    Clock::time_point nextFrameStart; // 下一帧的计划开始时间
+    float sleepOvershoot; // 睡眠比要求多出的时间 (平滑值，秒)，决定自旋余量
+    float lastWorkTime; // 上一帧除去等待之外的耗时
+    std::array<float, HISTORY_SIZE> intervals; // 最近的帧间隔 (环形缓冲)
+    int intervalCount; // 已记录的帧间隔数
+    int intervalIndex; // 下一次写入的位置
+
+    // 先睡眠到截止时间前的余量，再自旋到截止时间
+    void WaitUntil(Clock::time_point deadline);
+};
+
+#endif // FRAME_PACER_H
@@ -3,28 +3,65 @@
 #define GAME_H
 
 #include "raylib.h"
+#include "RenderSnapshot.h"
+#include "RenderCommandBuilder.h"
 #include "Dinosaur.h"
-#include "Obstacle.h"
-#include "Cloud.h"
 #include "Sword.h"
-#include "Bird.h"
+#include "EntityWorld.h"
+#include "EntitySystems.h"
 #include "InstructionManager.h"
+#include "TextureLibrary.h"
+#include "AnimationClip.h"
+#include "Snapshot.h"
+#include "SpawnGenerator.h"
+#include "PassabilityVerifier.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+#include "RenderCommandList.h"
+#include "UiLayerCache.h"
+#include "GroundStrip.h"
+#include "GroundDecalLayer.h"
+#include "ParallaxBackground.h"
+#include "DynamicResolution.h"
+#include "FramePacer.h"
+#include "AudioSystem.h"
+#include "AssetWatcher.h"
+#include "JobSystem.h"
+#include "FrameGraph.h"
 #include <vector>
-#include <deque>
-
-// 游戏状态
-enum class GameState
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// 抬头显示中的一段数值文字，只在显示的数值变化时重新格式化和排版
+struct HudCounter
 {
-    PLAYING, // 游戏中
-    GAME_OVER, // 游戏结束
-    PAUSED // 暂停
+    long long shownValue = -1; // 当前排版对应的数值
+    TextLayout layout; // 排好版的文字
 };
 
-// 路面
-struct Road
+// 主线程采集的一帧输入，由模拟线程消费
+struct InputFrame
 {
-    Texture2D texture; // 路面纹理
-    float xPosition; // 路面X轴位置
+    bool jumpPressed = false; // 按下跳跃
+    bool dashPressed = false; // 按下冲刺
+    bool pausePressed = false; // 按下暂停/继续
+    bool restartPressed = false; // 按下重新开始
+    bool quickSavePressed = false; // 按下快速存档
+    bool quickLoadPressed = false; // 按下快速读档
+    bool mouseClicked = false; // 按下鼠标左键 (攻击或点击按钮)
+    bool sneakHeld = false; // 按住潜行
+    float moveDirection = 0.0f; // 水平移动方向 (-1 到 1)
+    Vector2 virtualMousePos = {0, 0}; // 鼠标在虚拟屏幕中的坐标
+
+    // 合并一帧更新的输入：按下事件累积，按住状态取最新值
+    void Merge(const InputFrame& newer);
+    // 清除按下事件，只保留按住状态
+    void ClearPressed();
+    // 是否含有按下事件
+    bool HasPressed() const;
 };
 
 class Game
@@ -34,80 +71,160 @@ public:
     ~Game();
     void Run();
 
+    // 把完整的模拟状态写入一块连续快照 (只能在模拟线程或 Run 之外调用)
+    void SaveSnapshot(WorldSnapshot& snapshot) const;
+    // 从快照恢复模拟状态 (只能在模拟线程或 Run 之外调用)
+    // 标识或版本不符时不改动当前状态并返回 false；内容损坏时重置游戏并返回 false
+    bool LoadSnapshot(const WorldSnapshot& snapshot);
+    // 设置帧节奏模式 (主线程)；targetFps 只在 CAPPED 模式下使用
+    void SetFramePacing(FramePacingMode mode, int targetFps);
+    // 最近一段时间的帧间隔与抖动
+    FramePacingStats GetFramePacingStats() const { return framePacer.GetStats(); }
+
 private:
+    static constexpr int SIMULATION_TICK_RATE = 160; // 模拟线程每秒更新次数
+    static constexpr float MAX_SIMULATION_STEP = 0.05f; // 单步最大时长，卡顿后避免一步穿过障碍物
+    static constexpr float PERFORMANCE_TEXT_INTERVAL = 0.25f; // 性能信息刷新间隔 (秒)
+    static constexpr float IDLE_SETTLE_TIME = 0.1f; // 空闲时收到按键后继续轮询的时间，等模拟线程发布处理结果
+
     int screenWidth; // 屏幕宽度
     int screenHeight; // 屏幕高度
     const int virtualScreenWidth; // 虚拟屏幕宽度 (用于缩放)
     const int virtualScreenHeight; // 虚拟屏幕高度 (用于缩放)
-    RenderTexture2D targetRenderTexture; // 渲染目标纹理，用于实现缩放
-    Rectangle sourceRec; // 渲染纹理的源矩形
-    Rectangle destRec; // 渲染纹理的目标矩形
+    DynamicResolution dynamicResolution; // 动态内部分辨率 (各缩放级别的渲染纹理)
+    Rectangle destRec; // 渲染纹理的目标矩形 (整数像素)
     Vector2 origin; // 渲染纹理的原点
+    FramePacer framePacer; // 主线程帧节奏
+    bool showPerformance; // 是否显示性能信息 (F3)
+    float performanceTextTimer; // 距离下次刷新性能信息的时间
+    TextLayout performanceText; // 性能信息文字 (主线程)
+    TextLayout jobPerformanceText; // 任务图耗时与工作线程占用文字 (主线程)
+    bool redrawRequested; // 主线程自己的显示变化 (窗口大小、全屏、性能信息) 需要重画
+    float idleSettleTimer; // 空闲时剩余的轮询时间
 
     bool isFullscreen; // 是否全屏
     int windowedPosX, windowedPosY; // 窗口模式下的位置
     int windowedWidth, windowedHeight; // 窗口模式下的尺寸
 
-    Rectangle pause_restartButtonRect; // 暂停界面-重新开始按钮区域
-    Rectangle pause_exitButtonRect; // 暂停界面-退出按钮区域
-
-    Dinosaur* dino; // 玩家恐龙对象指针
-    Sword* playerSword; // 玩家的剑对象指针
-    std::vector<Obstacle> obstacles; // 障碍物列表
-    std::vector<Bird> birds; // 鸟类敌人列表
+    MenuLayout menuLayout; // 菜单布局 (启动时计算一次，点击检测与绘制共用)
+    UiLayerCache uiLayers; // 菜单界面缓存 (主线程)
+
+    std::thread simulationThread; // 模拟线程 (主线程只负责渲染和采集输入)
+    std::atomic<bool> simulationRunning; // 模拟线程是否运行
+    std::atomic<bool> simulationPauseRequested; // 主线程请求模拟线程在步与步之间停下 (替换资源时)
+    std::mutex simulationPauseMutex; // 保护 simulationPaused
+    std::condition_variable simulationPauseCondition; // 通知停下和继续
+    bool simulationPaused; // 模拟线程已经停下
+    AssetWatcher assetWatcher; // 资源热重载
+    std::atomic<bool> quitRequested; // 模拟线程请求退出游戏
+    SpscQueue<InputFrame, 64> inputFrames; // 主线程 -> 模拟线程的输入队列
+    InputFrame pendingInput; // 主线程尚未成功入队的输入 (仅主线程使用)
+    InputFrame simulationInput; // 模拟线程当前使用的输入 (仅模拟线程使用)
+    TripleBuffer<RenderSnapshot> renderSnapshots; // 模拟线程 -> 渲染线程的世界快照
+    RenderCommandList renderCommands; // 渲染线程每帧复用的绘制命令列表 (世界部分，合并后整帧)
+    RenderCommandList overlayCommands; // 与世界部分并行构建的覆盖部分命令列表
+    JobSystem jobSystem; // 每帧系统使用的工作窃取调度器
+    FrameGraph simulationGraph; // 模拟一步的任务图 (模拟线程运行)
+    FrameGraph renderGraph; // 渲染一帧的任务图 (主线程运行)
+    float simulationStepTime; // 本步的时长，供模拟任务图使用
+    const RenderSnapshot* renderFrame; // 本帧的世界快照，供渲染任务图使用
+    HudCounter hudScore; // 分数文字 (主线程)
+    HudCounter hudTime; // 时间文字，以0.1秒为单位 (主线程)
+
+    std::optional<Dinosaur> dino; // 玩家恐龙
+    std::optional<Sword> playerSword; // 玩家的剑
+    EntityWorld entities; // 障碍物和鸟等实体 (按原型的结构数组)
+    ArchetypeId cactusArchetype; // 仙人掌：移动、碰撞致死
+    ArchetypeId birdArchetype; // 鸟：飞行曲线、动画、碰撞致死、可被剑击杀
 
     GameState currentState; // 当前游戏状态
     float groundY; // 地面Y坐标
     float timePlayed; // 游戏已进行时间
+    float animationTime; // 全局动画时钟：所有动画按它加各自的相位取样，只在游戏进行中前进
     int score; // 当前得分
 
     float worldBaseScrollSpeed; // 世界基础滚动速度
     float currentWorldScrollSpeed; // 当前世界滚动速度
     float worldSpeedIncreaseRate; // 世界滚动速度增长率
 
-    float obstacleSpawnTimer; // 障碍物生成计时器
-    float minObstacleSpawnInterval; // 最小障碍物生成间隔
-    float maxObstacleSpawnInterval; // 最大障碍物生成间隔
-    float currentObstacleSpawnInterval; // 当前计算出的障碍物生成间隔
-
-    std::vector<Texture2D> dinoRunFrames; // 恐龙奔跑动画帧
-    std::vector<Texture2D> dinoSneakFrames; // 恐龙潜行动画帧
-    std::vector<Texture2D> smallCactusTextures; // 小仙人掌纹理
-    std::vector<Texture2D> bigCactusTextures; // 大仙人掌纹理
-    std::vector<Texture2D> roadSegmentTextures; // 路面片段纹理
-    std::vector<Texture2D> birdFrames; // 鸟飞行帧
-    Texture2D dinoDeadTexture; // 恐龙死亡纹理
-    Texture2D cloudTexture; // 云彩纹理
-    Texture2D swordTexture; // 剑的纹理
-
-    Sound jumpSound; // 跳跃音效
-    Sound dashSound; // 冲刺音效
-    Sound deadSound; // 死亡音效
-    Sound bombSound; // 爆炸音效
-    Sound swordSound; // 挥剑音效
-    Sound screamSound; // 鸟叫声音效
-    Music bgmMusic; // 背景音乐
-
+    SpawnGenerator spawnGenerator; // 后台分块生成器
+    SpawnGeometry spawnGeometry; // 生成实体的尺寸与摆放位置 (由纹理尺寸得出)
+    SpawnChunk currentSpawnChunk; // 正在消费的生成分块
+    int nextSpawnEventIndex; // 当前分块中下一个要生成的事件
+    float spawnDistanceRemaining; // 距离下一个生成事件还需滚动的距离
+
+    TextureGroup dinoRunFrames; // 恐龙奔跑动画帧
+    TextureGroup dinoSneakFrames; // 恐龙潜行动画帧
+    TextureGroup smallCactusTextures; // 小仙人掌纹理
+    TextureGroup bigCactusTextures; // 大仙人掌纹理
+    TextureGroup birdFrames; // 鸟飞行帧
+    AnimationClipId dinoRunClip; // 恐龙奔跑动画
+    AnimationClipId dinoSneakClip; // 恐龙潜行动画
+    AnimationClipId birdFlapClip; // 鸟扇翅动画
+    TextureHandle dinoDeadTexture; // 恐龙死亡纹理
+    TextureHandle cloudTexture; // 云彩纹理
+    TextureHandle swordTexture; // 剑的纹理
+
+    SoundHandle jumpSound; // 跳跃音效
+    SoundHandle dashSound; // 冲刺音效
+    SoundHandle deadSound; // 死亡音效
+    SoundHandle bombSound; // 爆炸音效
+    SoundHandle swordSound; // 挥剑音效
+    SoundHandle screamSound; // 鸟叫声音效
+    bool musicStarted; // 本局背景音乐是否已经开始 (模拟线程)
+
+    ParticleSystem dashTrailParticles; // 恐龙冲刺拖尾粒子系统
     ParticleSystem birdDeathParticles; // 鸟死亡粒子系统
     ParticleProperties birdDeathParticleProps; // 鸟死亡粒子属性
 
-    std::deque<Road> activeRoadSegments; // 当前激活的路面片段
-    std::deque<Cloud> activeClouds; // 存储当前屏幕上的云彩
-    float cloudSpawnTimerValue; // 云彩生成计时器
-    float nextCloudSpawnTime; // 下一次生成云彩的时间
+    GroundStrip ground; // 滚动路面
+    GroundDecalLayer groundDecals; // 烘焙落地粒子的路面印记层
+    ParallaxBackground background; // 视差背景 (云彩等)
 
     InstructionManager instructionManager; // 教学提示管理器
 
+    WorldSnapshot quickSaveSnapshot; // 快速存档 (F5 保存，F9 读取)
+
     // 初始化游戏
     void InitGame();
+    // 建立模拟和渲染的任务图 (结构只建立一次)
+    void BuildFrameGraphs();
     // 更新游戏逻辑
     void UpdateGame(float deltaTime);
-    // 绘制游戏画面
-    void DrawGame() const;
-    // 处理用户输入
+    // 绘制一帧世界快照
+    void DrawGame(const RenderSnapshot& frame);
+    // 显示的分数或时间变化时重新排版抬头显示
+    void UpdateHud(const RenderSnapshot& frame);
+    // 收集记录绘制命令所需的资源与界面状态 (主线程)
+    RenderInputs MakeRenderInputs() const;
+    // 采集用户输入并交给模拟线程 (主线程)
     void HandleInput();
-    // 生成障碍物或鸟
-    void SpawnObstacleOrBird();
+    // 这一帧是否需要重画：游戏进行中每帧都画，暂停和结束时只在画面会变化时画
+    bool NeedsRedraw(const RenderSnapshot& frame, bool freshSnapshot) const;
+    // 空闲时等待输入或窗口事件，不占用 CPU (主线程)
+    void WaitForIdleEvents();
+    // 模拟线程主循环
+    void SimulationLoop();
+    // 执行一帧输入对应的游戏逻辑 (模拟线程)
+    void ApplyInput(const InputFrame& input, float deltaTime);
+    // 进入游戏状态时开始背景音乐 (模拟线程)
+    void UpdateMusic();
+    // 停止并等待模拟线程
+    void StopSimulation();
+    // 让模拟线程在步与步之间停下并等待它停下 (主线程)
+    void PauseSimulation();
+    // 让停下的模拟线程继续 (主线程)
+    void ResumeSimulation();
+    // 模拟线程在步边界停下，直到主线程让它继续
+    void WaitWhileSimulationPaused();
+    // 在帧边界替换热重载的资源 (主线程)
+    void ApplyAssetReloads();
+    // 把当前世界状态复制到三缓冲并发布
+    void PublishRenderSnapshot();
+    // 按滚动距离消费预生成的分块
+    void UpdateSpawning(float scrolledDistance);
+    // 按生成事件生成障碍物或鸟 (overshoot 为本帧越过生成点的距离)
+    void SpawnObstacleOrBird(const SpawnEvent& event, float overshoot);
     // 检测碰撞
     void CheckCollisions();
     // 重置游戏状态
@@ -116,18 +233,14 @@ private:
     void LoadResources();
     // 卸载所有游戏资源
     void UnloadResources();
-    // 处理窗口大小改变事件
+    // 获取鼠标在虚拟屏幕中的坐标 (主线程)
+    Vector2 GetVirtualMousePosition() const;
+    // 处理窗口大小改变事件 (主线程)
     void HandleWindowResize();
     // 更新渲染纹理的缩放参数
     void UpdateRenderTextureScaling();
-    // 初始化路面
-    void InitRoads();
-    // 更新路面片段
-    void UpdateRoadSegments(float deltaTime);
-    // 生成云彩
-    void SpawnCloud();
-    // 更新云彩
-    void UpdateClouds(float deltaTime);
+    // 窗口与虚拟屏幕同样大且使用原始分辨率时直接绘制到屏幕，省去中间纹理
+    bool RendersDirectly() const;
 };
 
 #endif // GAME_H
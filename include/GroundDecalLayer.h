@@ -0,0 +1,88 @@
+// include/GroundDecalLayer.h
+#ifndef GROUND_DECAL_LAYER_H
+#define GROUND_DECAL_LAYER_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include "RenderCommandList.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// 一个落地粒子留下的印记
+struct GroundDecal
+{
+    Vector2 position = {0, 0}; // 中心位置 (记录时为屏幕坐标，进入状态后 x 为环形纹理列、y 相对条带顶部)
+    float size = 1.0f; // 边长
+    float rotation = 0.0f; // 旋转角度
+    Color color = WHITE; // 颜色
+};
+
+// 地面印记层的状态：最近印记的环形队列加路面累计滚动距离
+// 平凡可复制，可以直接放进渲染快照；渲染端按序号烘焙还没画过的印记
+struct GroundDecalState
+{
+    static constexpr int MAX_PENDING = 1024; // 等待烘焙的印记环容量，渲染落后太多时最早的印记被丢弃
+
+    std::array<GroundDecal, MAX_PENDING> stamps{}; // 最近的印记 (序号对容量取模存放)
+    std::uint64_t stampCount = 0; // 本代累计的印记数
+    double scrolled = 0.0; // 本代路面累计滚动距离
+    std::uint32_t generation = 0; // 每次清空加一，渲染端据此清空纹理
+};
+
+// 地面印记层：落地的粒子只画一次到随路面滚动的环形渲染纹理上，之后不再占用粒子池和绘制命令
+// 纹理按路面坐标对环宽取模存放，滚动只改变读取的起点，滚出屏幕的列在重新露出之前清空，
+// 所以印记可以无限累积而开销不变
+class GroundDecalLayer
+{
+public:
+    static constexpr int RING_MARGIN = 64; // 环宽比可见宽度多出的列数 (大于最大的印记)
+
+    GroundDecalLayer();
+
+    // 创建覆盖 [0, viewWidth) x [top, top + height) 的环形渲染纹理 (主线程，窗口创建后调用)
+    void Load(int viewWidth, float top, int height);
+    // 释放渲染纹理
+    void Unload();
+    // 清空所有印记 (新一局或读档，模拟线程)
+    void Reset();
+    // 记录一批落地粒子 (屏幕坐标，任意线程)
+    void Stamp(const std::vector<GroundDecal>& decals);
+    // 路面滚动之后调用 (模拟线程)：推进滚动距离，把记录的印记换算到环形纹理上并放进状态
+    void Advance(float scrolledDistance);
+    // 当前状态
+    const GroundDecalState& GetState() const { return state; }
+
+    // 清空滚出屏幕的列，再把状态中还没画过的印记画进纹理 (主线程，在任何 BeginTextureMode 之外调用)
+    void Bake(const GroundDecalState& bakeState);
+    // 按给定状态记录绘制命令 (只读取加载后不再改变的数据，可在渲染线程调用)
+    void Draw(const GroundDecalState& drawState, RenderCommandList& commands) const;
+
+private:
+    // 模拟端
+    GroundDecalState state; // 滚动距离与最近的印记
+    std::mutex stampMutex; // 保护 recorded
+    std::vector<GroundDecal> recorded; // 本步记录、还没换算的印记 (屏幕坐标)
+
+    // 加载后不再改变
+    int viewWidth; // 可见宽度
+    int ringWidth; // 环形纹理宽度
+    float top; // 条带顶部的屏幕 Y 坐标
+    int height; // 条带高度
+
+    // 渲染端 (主线程)
+    RenderTexture2D target; // 环形渲染纹理
+    TextureHandle targetHandle; // 环形纹理的句柄
+    std::uint32_t bakedGeneration; // 纹理对应的代
+    std::uint64_t bakedCount; // 已经画进纹理的印记数
+    long long bakedColumn; // 纹理最左侧可见列对应的路面坐标 (整数像素)
+    bool baked; // 纹理是否已经初始化
+
+    // 清空路面坐标 [first, first + count) 对应的列
+    void ClearColumns(long long first, long long count);
+    // 在环形纹理中画一个印记，跨过环的接缝时两边都画
+    void DrawStamp(const GroundDecal& decal) const;
+};
+
+#endif // GROUND_DECAL_LAYER_H
@@ -0,0 +1,53 @@
+// include/GroundStrip.h
+#ifndef GROUND_STRIP_H
+#define GROUND_STRIP_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include "RenderCommandList.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 路面条带的滚动状态：固定容量的片段下标环形队列加一个滚动偏移
+// 平凡可复制，可以直接写入存档和渲染快照
+struct GroundStripState
+{
+    static constexpr int MAX_SEGMENTS = 16; // 环形队列容量
+
+    std::array<std::uint8_t, MAX_SEGMENTS> segments{}; // 环中各位置的片段下标
+    int head = 0; // 最左侧片段在环中的位置
+    int count = 0; // 环中使用的位置数 (重置后不再改变)
+    float scrollOffset = 0.0f; // 最左侧片段已滚出屏幕左边的距离
+};
+
+// 滚动路面：所有片段拼在一张条带纹理上，滚动只改偏移，整条路面共用一张纹理一次批量绘制
+class GroundStrip
+{
+public:
+    GroundStrip();
+
+    // 把一组路面图片横向拼成一张条带纹理，路面需要铺满 width 宽 (主线程，窗口创建后调用)
+    // 宽度是虚拟屏幕宽度，窗口缩放不会改变它，所以缩放时路面保持原样
+    void Load(const std::vector<std::string>& paths, float width);
+    // 用随机片段重新铺满可见宽度
+    void Reset();
+    // 向左滚动一段距离，滚出屏幕的片段换成新的随机片段放到最右侧
+    void Scroll(float distance);
+    // 按给定状态绘制路面 (只读取加载后不再改变的数据，可在渲染线程调用)
+    void Draw(const GroundStripState& stripState, float y, RenderCommandList& commands) const;
+
+    // 当前滚动状态
+    const GroundStripState& GetState() const { return state; }
+    // 恢复滚动状态 (读档)，状态与当前片段不匹配时重新铺满
+    void SetState(const GroundStripState& newState);
+
+private:
+    TextureHandle stripTexture; // 拼好的条带纹理
+    std::vector<Rectangle> segmentRects; // 各片段在条带纹理中的区域
+    float viewWidth; // 需要铺满的宽度 (加载后不再改变)
+    GroundStripState state; // 滚动状态
+};
+
+#endif // GROUND_STRIP_H
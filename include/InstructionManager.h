@@ -28,20 +28,25 @@ public:
     // 获取所有当前激活且可碰撞的教学文本的矩形区域
     std::vector<Rectangle> GetAllActiveCollidableInstructionRects() const;
     // 初始化教学管理器
-    void Initialize(int virtualScreenWidth, float groundY, const Sound& bombSfx);
+    void Initialize(int virtualScreenWidth, float groundY, SoundHandle bombSfx);
     // 更新所有教学文本的状态
     void Update(float deltaTime, float worldScrollSpeed, float currentGameTime);
     // 绘制所有激活的教学文本
-    void Draw() const;
+    void Draw(RenderCommandList& commands) const;
     // 重置所有教学提示的状态
     void ResetAllInstructions();
 
+    // 将触发记录与激活中的教学文本写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复教学提示状态
+    void LoadState(SnapshotReader& reader);
+
 private:
     std::map<std::string, InstructionData> instructionConfigs; // 存储所有教学配置的映射表
     std::vector<InstructionText> activeInstructionTexts; // 当前屏幕上激活的教学文本列表
     int screenWidthRef; // 屏幕宽度
     float groundYRef; // 地面Y坐标
-    Sound bombSoundRef; // 爆炸音效
+    SoundHandle bombSoundRef; // 爆炸音效
 };
 
 #endif // INSTRUCTION_MANAGER_H
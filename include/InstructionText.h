@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 #include "ParticleSystem.h" // 包含粒子系统
+#include "Snapshot.h"
+#include "AudioSystem.h"
 
 // 教学文本状态枚举
 enum class InstructionTextState
@@ -32,14 +34,14 @@ public:
                     float fallGravity,
                     int virtualScreenWidth,
                     float groundY,
-                    const Sound& explosionSfx);
+                    SoundHandle explosionSfx);
 
     // 激活教学文本，使其开始显示
     void Activate(Vector2 startPos);
     // 更新教学文本状态 (如计时、掉落、爆炸)
     void Update(float deltaTime, float worldScrollSpeed);
     // 绘制教学文本
-    void Draw() const;
+    void Draw(RenderCommandList& commands) const;
     // 重置教学文本状态
     void Reset();
     // 检查教学文本是否已完成其生命周期
@@ -51,6 +53,11 @@ public:
     // 获取当前状态
     InstructionTextState GetCurrentState() const { return currentState; }
 
+    // 将教学文本状态写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复教学文本状态 (音效不在快照中，由调用者提供)
+    void LoadState(SnapshotReader& reader, SoundHandle explosionSfx);
+
 private:
     InstructionTextState currentState; // 当前状态
     std::string message; // 显示的文本信息
@@ -63,7 +70,7 @@ private:
     float currentTimer; // 当前计时器
     float gravity; // 掉落时的重力加速度
     float groundReferenceY; // 地面Y坐标参考 (用于停止掉落)
-    Sound bombSound; // 爆炸音效
+    SoundHandle bombSound; // 爆炸音效
 
     ParticleSystem explosionParticles; // 爆炸粒子效果
     ParticleProperties explosionParticleProps; // 爆炸粒子属性
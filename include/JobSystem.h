@@ -0,0 +1,92 @@
+// include/JobSystem.h
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 一个任务：函数指针加上下文，不需要分配内存
+struct Job
+{
+    void (*function)(void* context, int index); // 任务函数
+    void* context; // 上下文
+    int index; // 传给函数的序号
+};
+
+// 一个工作线程在一段时间内的统计
+struct WorkerStats
+{
+    float busyRatio = 0.0f; // 执行任务的时间占比
+    int jobsRun = 0; // 执行的任务数
+    int jobsStolen = 0; // 其中从其它线程偷来的任务数
+};
+
+// 工作窃取任务调度器：每个工作线程有自己的双端队列，自己从队尾取 (后进先出，缓存更热)，
+// 空闲时从其它线程的队首偷 (先进先出，偷走较早、通常较大的任务)；没有任务时线程睡眠
+class JobSystem
+{
+public:
+    // workerCount 为 0 时按核数决定 (留出主线程和模拟线程)
+    explicit JobSystem(int workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 提交任务 (任意线程)：工作线程放进自己的队列，其它线程轮流放进各队列
+    void Submit(const Job& job);
+    // 在调用线程上执行一个排队的任务 (等待任务图时帮忙)，没有任务时返回 false
+    bool TryRunOne();
+    // 对 [0, count) 的每个序号执行 function 并等待全部完成 (任意线程，可以在任务中嵌套调用)
+    // 调用线程执行序号 0，等待时帮忙执行排队的任务
+    void ParallelFor(int count, void (*function)(void* context, int index), void* context);
+
+    // 工作线程数
+    int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+    // 自上次调用以来各工作线程的统计 (只能由一个线程调用)
+    std::vector<WorkerStats> SampleWorkerStats();
+    // 当前线程的工作线程序号，不是工作线程时为 -1
+    static int CurrentWorker();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // 一个工作线程的任务队列
+    struct WorkQueue
+    {
+        std::mutex mutex; // 保护 jobs
+        std::deque<Job> jobs; // 排队的任务
+    };
+
+    // 一个工作线程的计数
+    struct WorkerCounters
+    {
+        std::atomic<int64_t> busyNanoseconds{0}; // 执行任务的累计时间
+        std::atomic<int> jobsRun{0}; // 执行的任务数
+        std::atomic<int> jobsStolen{0}; // 偷来的任务数
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues; // 各工作线程的队列
+    std::vector<std::unique_ptr<WorkerCounters>> counters; // 各工作线程的计数
+    std::vector<std::thread> workers; // 工作线程
+    std::atomic<int> queuedJobs; // 所有队列中的任务数
+    std::atomic<unsigned int> nextQueue; // 外部线程提交时轮流使用的队列
+    std::atomic<bool> running; // 工作线程是否运行
+    std::mutex sleepMutex; // 与 wake 配合
+    std::condition_variable wake; // 有新任务或退出时唤醒工作线程
+    Clock::time_point lastSample; // 上次统计的时间
+
+    // 工作线程主循环
+    void WorkerLoop(int index);
+    // 先从 preferred 队列的队尾取，再从其它队列的队首偷；stolen 表示是否是偷来的
+    bool Take(int preferred, Job& job, bool& stolen);
+};
+
+#endif // JOB_SYSTEM_H
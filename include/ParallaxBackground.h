@@ -0,0 +1,85 @@
+// include/ParallaxBackground.h
+#ifndef PARALLAX_BACKGROUND_H
+#define PARALLAX_BACKGROUND_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include "RenderCommandList.h"
+#include "Snapshot.h"
+#include <vector>
+
+// 视差层配置 (加载资源时设置，之后不再改变)
+struct ParallaxLayerConfig
+{
+    TextureHandle texture = INVALID_TEXTURE; // 实例使用的纹理
+    float depth = 1.0f; // 深度，越大越远、越先绘制
+    float scrollFactor = 0.0f; // 跟随世界滚动的比例 (0 为不随世界移动，1 与路面同速)
+    float driftSpeedMin = 0.0f, driftSpeedMax = 0.0f; // 实例自身向左漂移的速度范围
+    float scaleMin = 1.0f, scaleMax = 1.0f; // 实例缩放范围
+    float minY = 0.0f, maxY = 0.0f; // 实例左上角的Y坐标范围
+    float spawnGapMin = 0.0f, spawnGapMax = 0.0f; // 新实例出现在屏幕右边缘之外的距离范围
+    float spawnIntervalMin = 1.0f, spawnIntervalMax = 1.0f; // 生成间隔范围 (秒)
+    int initialCount = 0; // 重置时散布在屏幕内的实例数 (如星空)
+    int capacity = 16; // 实例池容量，池满时跳过生成
+    Color tint = WHITE; // 颜色
+};
+
+// 视差层中的一个实例
+struct ParallaxInstance
+{
+    Vector2 position; // 左上角位置
+    float driftSpeed; // 自身漂移速度
+    float scale; // 缩放
+};
+
+// 一个视差层的运行状态
+struct ParallaxLayerState
+{
+    std::vector<ParallaxInstance> instances; // 存活的实例 (容量固定为配置的池容量)
+    float spawnTimer = 0.0f; // 生成计时器
+    float nextSpawnTime = 0.0f; // 下一次生成的时间
+};
+
+// 所有视差层的运行状态，按层添加的顺序排列
+using ParallaxState = std::vector<ParallaxLayerState>;
+
+// 多层视差背景：每层是一个固定容量的实例池，绘制时每层只提交一个纹理批次
+class ParallaxBackground
+{
+public:
+    ParallaxBackground();
+
+    // 设置需要覆盖的视口宽度
+    void SetViewWidth(float width);
+    // 移除所有层 (重新加载资源前调用)
+    void ClearLayers();
+    // 添加一个视差层并为其预留实例池 (主线程，模拟线程启动前调用)
+    void AddLayer(const ParallaxLayerConfig& config);
+    // 清空所有实例并按配置重新散布初始实例
+    void Reset();
+    // 按世界滚动速度移动实例，移除离开屏幕的实例并按计时生成新实例
+    void Update(float deltaTime, float worldScrollSpeed);
+    // 按给定状态绘制所有层 (只读取加载后不再改变的配置，可在渲染线程调用)
+    void Draw(const ParallaxState& drawState, RenderCommandList& commands) const;
+
+    // 当前运行状态
+    const ParallaxState& GetState() const { return state; }
+    // 写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复，层数或实例数与配置不符时重置
+    void LoadState(SnapshotReader& reader);
+
+private:
+    std::vector<ParallaxLayerConfig> configs; // 各层配置
+    std::vector<Vector2> textureSizes; // 各层纹理尺寸
+    std::vector<int> drawOrder; // 按深度从远到近排列的层下标
+    float viewWidth; // 视口宽度
+    ParallaxState state; // 运行状态
+
+    // 在指定层生成一个实例 (池满时跳过)
+    void SpawnInstance(int layerIndex, float x);
+    // 一个实例的绘制宽度
+    float InstanceWidth(int layerIndex, const ParallaxInstance& instance) const;
+};
+
+#endif // PARALLAX_BACKGROUND_H
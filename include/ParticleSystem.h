@@ -4,6 +4,11 @@
 
 #include "raylib.h"
 #include "Utils.h"
+#include "Snapshot.h"
+#include "RenderCommandList.h"
+#include "CacheAlignedAllocator.h"
+#include "JobSystem.h"
+#include "GroundDecalLayer.h"
 #include <vector>
 #include <string>
 
@@ -44,32 +49,89 @@ struct ParticleProperties
     float targetGroundY = -1.0f; // 目标地面Y坐标
 };
 
+// 一个激活粒子的绘制数据
+struct ParticleSprite
+{
+    Vector2 position = {0, 0}; // 中心位置
+    float size = 1.0f; // 边长
+    float rotation = 0.0f; // 旋转角度
+    Color color = WHITE; // 颜色
+};
+
+// 渲染快照中的粒子：只保存激活粒子的绘制数据，发布快照的开销随激活粒子数增长而与粒子池大小无关
+struct ParticleSnapshot
+{
+    std::vector<ParticleSprite> sprites; // 激活粒子 (按粒子池中的顺序)
+
+    // 把粒子记录到指定层 (与 ParticleSystem::Draw 的画法相同)
+    void Draw(RenderCommandList& commands, RenderLayer layer) const;
+};
+
 // 粒子系统管理器
+// 激活粒子很多时按固定大小的分块在多个核上并行更新；粒子之间互不影响且分块大小与线程数无关，结果总是确定的
+// 设置了地面印记层时，落地的粒子烘焙成印记并立即释放，否则留在地面上随路面滚动直到寿命结束
 class ParticleSystem
 {
 public:
-    ParticleSystem(int maxParticlesCount);
+    static constexpr int PARALLEL_UPDATE_THRESHOLD = 16384; // 激活粒子超过这个数量时并行更新
+    static constexpr int UPDATE_CHUNK_SIZE = 4096; // 并行更新时每块的粒子数
+    static constexpr int STRESS_POOL_SIZE = 1 << 20; // 压力模式下每个粒子池的大小
+    static constexpr int EMIT_BLOCK_SIZE = 256; // 批量发射时每块的粒子数
+    static constexpr int EMIT_RANDOM_COUNT = 8; // 每个粒子使用的随机数个数
+
+    // scalesWithStress 为 false 时压力模式下不扩大粒子池 (用于随所属对象整体复制进渲染快照的粒子池)
+    explicit ParticleSystem(int maxParticlesCount, bool scalesWithStress = true);
     ~ParticleSystem();
 
     // 更新所有激活粒子的状态
     void Update(float deltaTime);
-    // 绘制所有激活粒子
-    void Draw() const;
+    // 把所有激活粒子记录到指定层
+    void Draw(RenderCommandList& commands, RenderLayer layer) const;
+    // 把激活粒子紧凑地复制进渲染快照 (复用快照已有的容量)
+    void CopyActiveTo(ParticleSnapshot& snapshot) const;
 
     // 从指定位置发射指定数量的粒子
     void Emit(Vector2 emitterPosition, int count, const ParticleProperties& props, float worldScrollSpeedX = 0.0f);
+    // 在区域内的随机位置批量发射指定数量的粒子 (随机数整块生成，直接写入对象池)
+    void EmitInArea(Rectangle area, int count, const ParticleProperties& props, float worldScrollSpeedX = 0.0f);
 
     // 设置整个粒子系统的重力向量
     void SetGravity(Vector2 newGravity);
     // 重置粒子池，使所有粒子变为非激活状态
     void Reset();
     // 获取当前激活的粒子数量
-    int GetActiveParticlesCount() const;
+    int GetActiveParticlesCount() const { return activeCount; }
+    // 设置并行更新使用的调度器 (所有粒子系统共用，为空时总是串行更新)
+    static void SetJobSystem(JobSystem* jobs);
+    // 压力模式：每次发射的数量乘以 emitMultiplier，之后创建的非空粒子池扩大到 STRESS_POOL_SIZE
+    // (scalesWithStress 为 false 的除外)
+    // (需要在创建粒子系统之前调用，倍数为 1 时关闭)
+    static void SetStressMode(int emitMultiplier);
+    // 设置落地粒子烘焙进的印记层 (所有粒子系统共用，为空时落地粒子留在池中)
+    static void SetGroundDecals(GroundDecalLayer* decals);
+
+    // 将粒子池状态写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复粒子池状态
+    void LoadState(SnapshotReader& reader);
 
 private:
-    std::vector<Particle> particlesPool; // 粒子对象池
+    std::vector<Particle, CacheAlignedAllocator<Particle>> particlesPool; // 粒子对象池 (按缓存行对齐，分块不伪共享)
     int poolIndex; // 对象池当前索引，用于循环使用粒子
     Vector2 systemGravity; // 粒子系统应用的重力
+    int activeCount; // 激活的粒子数
+    std::vector<int> chunkActiveCounts; // 并行更新时各分块更新后的激活粒子数
+    std::vector<std::vector<GroundDecal>> chunkSettled; // 各分块本次落地的粒子 (按分块顺序交给印记层)
+    static JobSystem* jobSystem; // 并行更新使用的调度器
+    static int stressEmitMultiplier; // 压力模式的发射倍数 (1 表示关闭)
+    static GroundDecalLayer* groundDecals; // 落地粒子烘焙进的印记层
+
+    // 更新 [first, last) 范围内的粒子，返回其中仍然激活的粒子数；烘焙的落地粒子追加到 settled
+    int UpdateRange(int first, int last, float deltaTime, std::vector<GroundDecal>& settled);
+    // 把各分块落地的粒子交给印记层
+    void FlushSettled(int chunkCount);
+    // 调度器回调：更新一个分块
+    static void UpdateChunkJob(void* context, int chunk);
 };
 
 #endif // PARTICLE_SYSTEM_H
@@ -0,0 +1,59 @@
+// include/PassabilityVerifier.h
+#ifndef PASSABILITY_VERIFIER_H
+#define PASSABILITY_VERIFIER_H
+
+#include "Dinosaur.h"
+#include "SpawnGenerator.h"
+#include <vector>
+
+// 离散搜索的精度设置
+struct PassabilitySearchSettings
+{
+    float timeStep = 1.0f / 30.0f; // 模拟步长 (秒)
+    float positionResolution = 16.0f; // X坐标合并精度 (像素)
+    float heightResolution = 4.0f; // Y坐标合并精度 (像素)
+    float velocityResolution = 60.0f; // 竖直速度合并精度 (像素/秒)
+    int maxFrontierStates = 256; // 每步最多保留的搜索状态数 (超出时均匀抽样)
+    int contextEvents = 3; // 验证分块时带上前一个分块末尾的事件数
+    float maxSimulatedSeconds = 60.0f; // 单次验证最多模拟的时长
+};
+
+// 一个种子的批量验证结果
+struct SeedVerificationResult
+{
+    unsigned int seed = 0; // 种子
+    int chunksChecked = 0; // 验证过的分块数
+    int unfairChunks = 0; // 生成后无法直接通过的分块数
+    int firstUnfairChunk = -1; // 第一个无法直接通过的分块序号 (-1 表示全部可通过)
+    int regeneratedChunks = 0; // 换种子后通过的分块数
+    int repairedChunks = 0; // 拉大间隔后通过的分块数
+    int fallbackChunks = 0; // 修复失败、换成保底分块的分块数
+};
+
+// 通关验证器：用恐龙的运动模型对生成序列做离散可达性搜索，判断是否存在活下来的操作序列
+// 所有方法都是 const 且不访问全局状态，可以在多个线程中同时使用
+class PassabilityVerifier
+{
+public:
+    PassabilityVerifier(const DinoMovementModel& movementModel, const SpawnGeometry& spawnGeometry,
+                        const PassabilitySearchSettings& searchSettings = PassabilitySearchSettings{});
+
+    // 判断从站在地面开始，这串生成事件是否可以通过
+    bool IsPassable(const SpawnEvent* events, int eventCount,
+                    float startScrollSpeed, float scrollSpeedIncreaseRate) const;
+    // 判断分块是否可以通过 (带上前一个分块末尾的事件作为上下文)
+    bool IsChunkPassable(const SpawnGeneratorConfig& config, const SpawnChunk& chunk,
+                         const SpawnChunk* previousChunk) const;
+    // 在多个线程上并行验证一批种子各自的前 chunksPerSeed 个分块 (threadCount 为0时使用全部核心)
+    // 分块按游戏中的方式生成 (验证失败时重试、修复或换成保底分块)，并统计各种结果的次数
+    std::vector<SeedVerificationResult> VerifySeeds(const SpawnGeneratorConfig& config,
+                                                    const std::vector<unsigned int>& seeds,
+                                                    int chunksPerSeed, unsigned int threadCount = 0) const;
+
+private:
+    DinoMovementModel movement; // 恐龙运动参数
+    SpawnGeometry geometry; // 实体尺寸与摆放位置
+    PassabilitySearchSettings settings; // 搜索精度
+};
+
+#endif // PASSABILITY_VERIFIER_H
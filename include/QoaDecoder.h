@@ -0,0 +1,58 @@
+// include/QoaDecoder.h
+#ifndef QOA_DECODER_H
+#define QOA_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// QOA (Quite OK Audio) 流式解码器：文件以压缩形式保存在内存中，每次只解码一帧 (5120 个采样)
+// 每帧头部带有完整的预测器状态，所以可以精确跳转到任意采样
+class QoaDecoder
+{
+public:
+    static constexpr uint32_t FRAME_LENGTH = 5120; // 每帧的采样数 (每声道)
+    static constexpr uint32_t SLICE_LENGTH = 20; // 每个分片的采样数
+    static constexpr uint32_t MAX_CHANNELS = 8; // 最大声道数
+
+    QoaDecoder();
+
+    // 打开内存中的 QOA 文件数据，格式不对时返回 false
+    bool Open(std::vector<uint8_t> fileData);
+    // 关闭并释放数据
+    void Close();
+    // 跳到指定采样位置 (每声道的采样序号)
+    void Seek(uint32_t frame);
+    // 读取最多 frameCount 个采样帧 (交错的 16 位采样)，返回实际读取的帧数，到结尾时少于请求
+    uint32_t Read(int16_t* output, uint32_t frameCount);
+
+    // 是否已打开
+    bool IsOpen() const { return channels > 0; }
+    // 声道数
+    uint32_t GetChannels() const { return channels; }
+    // 采样率
+    uint32_t GetSampleRate() const { return sampleRate; }
+    // 总采样帧数
+    uint32_t GetTotalFrames() const { return totalFrames; }
+    // 当前采样位置
+    uint32_t GetPosition() const { return position; }
+
+private:
+    std::vector<uint8_t> data; // 压缩的文件数据
+    std::vector<int16_t> frameSamples; // 当前已解码的一帧 (交错)
+    uint32_t channels; // 声道数
+    uint32_t sampleRate; // 采样率
+    uint32_t totalFrames; // 总采样帧数
+    uint32_t position; // 当前采样位置
+    uint32_t decodedFrame; // frameSamples 中是第几帧，未解码时为 UINT32_MAX
+    uint32_t decodedLength; // frameSamples 中的采样帧数
+
+    // 第 index 帧在文件中的字节偏移
+    size_t FrameOffset(uint32_t index) const;
+    // 解码第 index 帧到 frameSamples，数据损坏时返回 false
+    bool DecodeFrame(uint32_t index);
+    // 按大端读取 8 字节
+    uint64_t ReadU64(size_t offset) const;
+};
+
+#endif // QOA_DECODER_H
@@ -0,0 +1,39 @@
+// include/RenderCommandBuilder.h
+#ifndef RENDER_COMMAND_BUILDER_H
+#define RENDER_COMMAND_BUILDER_H
+
+#include "RenderSnapshot.h"
+#include "RenderCommandList.h"
+#include "TextLayoutCache.h"
+
+// 记录一帧绘制命令时需要、但不在世界快照中的输入：加载后不变的资源和主线程维护的界面状态
+// 指针为空或句柄无效的部分不绘制，测试可以只提供需要的部分
+struct RenderInputs
+{
+    Rectangle viewport = {0.0f, 0.0f, 960.0f, 540.0f}; // 虚拟屏幕 (也是剔除视口)
+    RenderResourceHooks resources; // 纹理尺寸与文字排版的来源
+    const ParallaxBackground* background = nullptr; // 视差背景的图层配置
+    const GroundStrip* ground = nullptr; // 路面片段
+    const GroundDecalLayer* groundDecals = nullptr; // 路面印记的环形纹理
+    const TextLayout* scoreText = nullptr; // 分数文字
+    const TextLayout* timeText = nullptr; // 时间文字
+    const TextLayout* performanceText = nullptr; // 性能信息文字 (不显示时为空)
+    const TextLayout* jobPerformanceText = nullptr; // 任务图耗时文字 (不显示时为空)
+    TextureHandle gameOverLayer = INVALID_TEXTURE; // 缓存的游戏结束界面
+    TextureHandle pauseLayer = INVALID_TEXTURE; // 缓存的暂停界面
+    Rectangle uiSource = {0.0f, 0.0f, 0.0f, 0.0f}; // 缓存界面的源矩形
+};
+
+// 把世界快照记录为绘制命令：只记录不提交，不调用任何 GPU 接口
+// 纹理尺寸和文字排版通过 RenderInputs::resources 查询，没有窗口时也能构建命令列表并检查绘制调用数与剔除效果
+namespace RenderCommandBuilder
+{
+    // 清空列表并记录整帧的命令 (世界部分加覆盖部分)
+    void Build(const RenderSnapshot& frame, const RenderInputs& inputs, RenderCommandList& commands);
+    // 清空列表并记录世界部分：背景、路面、恐龙、实体、剑和粒子
+    void BuildWorld(const RenderSnapshot& frame, const RenderInputs& inputs, RenderCommandList& commands);
+    // 清空列表并记录覆盖部分：抬头显示、教学文本和菜单
+    void BuildOverlay(const RenderSnapshot& frame, const RenderInputs& inputs, RenderCommandList& commands);
+}
+
+#endif // RENDER_COMMAND_BUILDER_H
@@ -0,0 +1,151 @@
+// include/RenderCommandList.h
+#ifndef RENDER_COMMAND_LIST_H
+#define RENDER_COMMAND_LIST_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include "TextLayoutCache.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 绘制层，按数值从小到大绘制；同一层内的命令按纹理排序，所以可能互相重叠的内容要放在不同的层
+enum class RenderLayer : uint8_t
+{
+    BACKGROUND, // 视差背景 (层内按深度绘制)
+    GROUND, // 路面
+    GROUND_DECALS, // 烘焙在路面上的落地粒子
+    PLAYER_TRAIL, // 冲刺拖尾粒子
+    PLAYER, // 恐龙
+    PLAYER_HUD, // 恐龙头顶的冷却条
+    OBSTACLES, // 仙人掌和鸟
+    WEAPON, // 剑
+    PARTICLES, // 鸟死亡粒子
+    HUD, // 分数和时间
+    INSTRUCTIONS, // 教学文本
+    INSTRUCTION_PARTICLES, // 教学文本爆炸粒子
+    OVERLAY, // 菜单遮罩
+    UI // 缓存的菜单界面
+};
+
+// 绘制命令类型
+enum class RenderCommandType : uint8_t
+{
+    TEXTURE, // 纹理 (DrawTexturePro)
+    RECTANGLE, // 实心矩形 (DrawRectanglePro)
+    RECTANGLE_LINES, // 矩形边框 (DrawRectangleLinesEx)
+    TEXT, // 默认字体文字 (DrawText)
+    TEXTURE_BATCH // 同一纹理、同一源矩形的一批实例 (连续 DrawTexturePro)
+};
+
+// 一条绘制命令
+struct RenderCommand
+{
+    RenderLayer layer; // 所在层
+    uint8_t depth; // 层内的绘制顺序 (只有批次命令使用，其余为 0)
+    RenderCommandType type; // 命令类型
+    TextureHandle texture; // 纹理句柄 (非纹理命令为 INVALID_TEXTURE)
+    Rectangle source; // 纹理源矩形 (宽度为负表示水平翻转)
+    Rectangle dest; // 目标矩形 (文字只使用 x, y)
+    Vector2 origin; // 旋转原点 (相对目标矩形左上角)
+    float rotation; // 旋转角度
+    float lineThickness; // 边框线宽
+    int fontSize; // 字号
+    int textOffset; // 文字在文字缓冲中的起始位置
+    int batchOffset; // 批次实例在实例缓冲中的起始位置
+    int batchCount; // 批次实例数
+    Color tint; // 颜色
+};
+
+// 命令列表统计，用于在没有 GPU 的环境下检查绘制调用与剔除效果
+struct RenderListStats
+{
+    int commandCount = 0; // 提交的命令数
+    int culledCount = 0; // 因在视口外被剔除的命令数
+    int textureSwitches = 0; // 按当前顺序提交时纹理切换 (批次中断) 的次数
+};
+
+// 记录命令时查询资源的钩子：默认使用纹理库和文字排版缓存
+// 没有窗口和 GPU 时 (如测试) 可以换成给出固定尺寸和排版的实现
+struct RenderResourceHooks
+{
+    // 纹理尺寸 (宽, 高)
+    Vector2 (*textureSize)(TextureHandle texture) = DefaultTextureSize;
+    // 默认字体按 DrawText 参数的文字排版 (返回的引用在本帧内有效)
+    const TextLayout& (*layoutText)(const std::string& text, int fontSize) = TextLayoutCache::GetDefault;
+
+    // 从纹理库读取纹理尺寸
+    static Vector2 DefaultTextureSize(TextureHandle texture);
+};
+
+// 帧内绘制命令列表：构建阶段只记录命令，不调用任何 GPU 接口；排序后一次性提交
+class RenderCommandList
+{
+public:
+    RenderCommandList();
+
+    // 清空命令并设置本帧用于剔除的视口
+    void Begin(Rectangle newViewport);
+    // 设置查询纹理尺寸和文字排版的钩子 (Begin 不会重置)
+    void SetResourceHooks(const RenderResourceHooks& hooks) { resources = hooks; }
+    // 纹理尺寸 (宽, 高)
+    Vector2 GetTextureSize(const TextureHandle texture) const { return resources.textureSize(texture); }
+    // 默认字体的文字排版
+    const TextLayout& LayoutText(const std::string& text, const int fontSize) const
+    {
+        return resources.layoutText(text, fontSize);
+    }
+    // 添加纹理命令 (完全在视口外时剔除)
+    void AddTexture(RenderLayer layer, TextureHandle texture, Rectangle source, Rectangle dest,
+                    Vector2 origin = {0, 0}, float rotation = 0.0f, Color tint = WHITE);
+    // 以左上角位置添加整张纹理
+    void AddTexture(RenderLayer layer, TextureHandle texture, Vector2 position, Color tint = WHITE);
+    // 添加实心矩形命令
+    void AddRectangle(RenderLayer layer, Rectangle rect, Color color, Vector2 origin = {0, 0}, float rotation = 0.0f);
+    // 添加矩形边框命令
+    void AddRectangleLines(RenderLayer layer, Rectangle rect, float lineThickness, Color color);
+    // 添加文字命令 (文字会被复制，调用后原字符串可以立即释放)
+    void AddText(RenderLayer layer, const char* text, int x, int y, int fontSize, Color color);
+    // 把排好版的文字按字形添加为纹理命令，可以与其它文字合批
+    void AddTextLayout(RenderLayer layer, const TextLayout& layout, Vector2 position, Color color);
+    // 开始一个纹理批次：之后添加的实例共用纹理、源矩形和颜色，整批只占一条命令
+    // depth 决定同一层内各批次的先后 (小的先画)
+    void BeginTextureBatch(RenderLayer layer, uint8_t depth, TextureHandle texture, Rectangle source, Color tint = WHITE);
+    // 向当前批次添加一个实例 (完全在视口外时剔除)
+    void AddBatchInstance(Rectangle dest);
+    // 按层、深度、类型、纹理稳定排序，相同纹理的命令会连续提交
+    void Sort();
+    // 把另一个列表的命令追加到末尾 (文字和批次实例一并复制)，用于合并并行构建的列表
+    void Append(const RenderCommandList& other);
+    // 按当前顺序提交所有命令 (需要在 BeginDrawing/BeginTextureMode 之间调用)
+    void Submit() const;
+
+    // 获取所有命令
+    const std::vector<RenderCommand>& GetCommands() const { return commands; }
+    // 获取批次命令的实例目标矩形
+    const Rectangle* GetBatchInstances(const RenderCommand& command) const
+    {
+        return batchInstances.data() + command.batchOffset;
+    }
+    // 获取命令中的文字
+    const char* GetText(const RenderCommand& command) const { return textBuffer.data() + command.textOffset; }
+    // 统计命令数量、剔除数量与纹理切换次数
+    RenderListStats GetStats() const;
+
+private:
+    std::vector<RenderCommand> commands; // 本帧命令
+    std::vector<char> textBuffer; // 文字缓冲 (每段文字以 '\0' 结尾)
+    std::vector<Rectangle> batchInstances; // 批次实例缓冲
+    RenderCommand pendingBatch; // 已开始但还没有实例的批次
+    int openBatch; // 正在添加实例的批次命令下标 (-1 表示还没有放入命令列表)
+    Rectangle viewport; // 剔除视口
+    int culledCount; // 本帧被剔除的命令数
+    RenderResourceHooks resources; // 纹理尺寸与文字排版的来源
+
+    // 判断 (可能旋转的) 目标矩形是否完全在视口外
+    bool IsOutsideViewport(Rectangle dest, Vector2 origin, float rotation) const;
+    // 创建一条填好公共字段的命令
+    static RenderCommand MakeCommand(RenderLayer layer, RenderCommandType type, Rectangle dest, Color tint);
+};
+
+#endif // RENDER_COMMAND_LIST_H
@@ -0,0 +1,46 @@
+// include/RenderSnapshot.h
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "Dinosaur.h"
+#include "Sword.h"
+#include "EntityWorld.h"
+#include "InstructionManager.h"
+#include "ParticleSystem.h"
+#include "GroundStrip.h"
+#include "GroundDecalLayer.h"
+#include "ParallaxBackground.h"
+#include "FrameGraph.h"
+#include <optional>
+#include <vector>
+
+// 游戏状态
+enum class GameState
+{
+    PLAYING, // 游戏中
+    GAME_OVER, // 游戏结束
+    PAUSED // 暂停
+};
+
+// 模拟线程发布给渲染线程的只读世界快照
+struct RenderSnapshot
+{
+    GameState state = GameState::PAUSED; // 游戏状态
+    float groundY = 0.0f; // 地面Y坐标
+    float timePlayed = 0.0f; // 游戏已进行时间
+    float animationTime = 0.0f; // 全局动画时钟
+    int score = 0; // 当前得分
+    std::optional<Dinosaur> dino; // 玩家恐龙
+    std::optional<Sword> playerSword; // 玩家的剑
+    EntityWorld entities; // 障碍物和鸟等实体
+    ParallaxState background; // 视差背景实例
+    GroundStripState ground; // 路面滚动状态
+    GroundDecalState groundDecals; // 路面印记的滚动距离与等待烘焙的印记
+    ParticleSnapshot dashTrailParticles; // 冲刺拖尾粒子 (只含激活粒子)
+    ParticleSnapshot birdDeathParticles; // 鸟死亡粒子 (只含激活粒子)
+    InstructionManager instructionManager; // 教学提示
+    std::vector<JobTiming> simulationJobs; // 最近一步模拟任务图中各任务的耗时
+    float simulationGraphTime = 0.0f; // 最近一步模拟任务图的总耗时 (毫秒)
+};
+
+#endif // RENDER_SNAPSHOT_H
@@ -0,0 +1,164 @@
+// include/Snapshot.h
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <vector>
+#include <string>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+// 世界快照：整个模拟状态按顺序写入的一块连续内存
+using WorldSnapshot = std::vector<unsigned char>;
+
+// 快照写入器，把平凡可复制的数据追加到缓冲区末尾
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(WorldSnapshot& buffer) : buffer(buffer) {}
+
+    // 写入单个值
+    template <typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "快照只能直接写入平凡可复制的类型");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    // 写入一段连续数组 (整块复制)
+    template <typename T>
+    void WriteArray(const T* data, const size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "快照只能直接写入平凡可复制的类型");
+        WriteBytes(data, sizeof(T) * count);
+    }
+
+    // 写入 vector (先写数量，再整块写入元素)
+    template <typename T, typename Allocator>
+    void WriteVector(const std::vector<T, Allocator>& values)
+    {
+        Write(values.size());
+        WriteArray(values.data(), values.size());
+    }
+
+    // 写入字符串
+    void WriteString(const std::string& text)
+    {
+        Write(text.size());
+        WriteBytes(text.data(), text.size());
+    }
+
+private:
+    WorldSnapshot& buffer; // 目标缓冲区
+
+    void WriteBytes(const void* data, const size_t size)
+    {
+        if (size == 0) return;
+        const size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        std::memcpy(buffer.data() + offset, data, size);
+    }
+};
+
+// 快照读取器，按写入顺序读取；越界时进入失败状态，之后的读取都会返回 false
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(const WorldSnapshot& buffer) : buffer(buffer), offset(0), failed(false) {}
+
+    // 读取单个值
+    template <typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "快照只能直接读取平凡可复制的类型");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    // 读取一段连续数组
+    template <typename T>
+    bool ReadArray(T* data, const size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "快照只能直接读取平凡可复制的类型");
+        return ReadBytes(data, sizeof(T) * count);
+    }
+
+    // 读取 vector，元素类型不需要默认构造函数
+    // 元素数在分配前与剩余字节数比较 (不做乘法，损坏的元素数不会溢出绕过检查)
+    template <typename T, typename Allocator>
+    bool ReadVector(std::vector<T, Allocator>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "快照只能直接读取平凡可复制的类型");
+        size_t count = 0;
+        if (!Read(count) || !CanReadElements(count, sizeof(T))) return false;
+        values.clear();
+        if constexpr (std::is_default_constructible_v<T>)
+        {
+            // 一次复制整段，恢复大粒子池时不逐个追加
+            values.resize(count);
+            return ReadBytes(values.data(), sizeof(T) * count);
+        }
+        else
+        {
+            values.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::array<unsigned char, sizeof(T)> raw{};
+                ReadBytes(raw.data(), raw.size());
+                values.push_back(std::bit_cast<T>(raw));
+            }
+            return true;
+        }
+    }
+
+    // 读取字符串
+    bool ReadString(std::string& text)
+    {
+        size_t length = 0;
+        if (!Read(length) || !CanRead(length)) return false;
+        text.assign(reinterpret_cast<const char*>(buffer.data() + offset), length);
+        offset += length;
+        return true;
+    }
+
+    // 是否全部读取成功
+    bool IsValid() const { return !failed; }
+    // 是否已读到末尾
+    bool IsAtEnd() const { return offset == buffer.size(); }
+
+private:
+    const WorldSnapshot& buffer; // 源缓冲区
+    size_t offset; // 当前读取位置
+    bool failed; // 是否发生过越界
+
+    // 剩余字节能否容纳 count 个 elementSize 字节的元素
+    bool CanReadElements(const size_t count, const size_t elementSize)
+    {
+        if (failed || count > (buffer.size() - offset) / elementSize)
+        {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool CanRead(const size_t size)
+    {
+        if (failed || size > buffer.size() - offset)
+        {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadBytes(void* data, const size_t size)
+    {
+        if (!CanRead(size)) return false;
+        if (size > 0) std::memcpy(data, buffer.data() + offset, size);
+        offset += size;
+        return true;
+    }
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,48 @@
+// include/SoundCache.h
+#ifndef SOUND_CACHE_H
+#define SOUND_CACHE_H
+
+#include "raylib.h"
+#include <atomic>
+#include <cstdint>
+
+// 音频设备的混音格式 (32 位浮点)
+struct AudioDeviceFormat
+{
+    unsigned int sampleRate = 0; // 采样率
+    unsigned int channels = 0; // 声道数
+};
+
+// 音效磁盘缓存：把音效预先转换成音频设备的混音格式存到磁盘，以源文件内容的哈希为键
+// 缓存命中时跳过解码和重采样，直接把设备格式的采样交给 raylib；源文件改动后哈希变化，自动重新转换
+class SoundCache
+{
+public:
+    static constexpr const char* CACHE_DIRECTORY = "cache/sfx"; // 缓存目录
+
+    // 加载音效 (需要音频设备已初始化)，优先使用缓存
+    static Sound Load(const char* path);
+    // 加载设备格式的波形，优先使用缓存；设备格式探测过之后可以在其它线程调用
+    static Wave LoadWave(const char* path);
+    // 音频设备的混音格式，第一次调用时探测 (主线程)
+    static AudioDeviceFormat GetDeviceFormat();
+
+    // 本次运行中缓存命中的次数
+    static int GetHitCount() { return hitCount.load(std::memory_order_relaxed); }
+    // 本次运行中重新转换的次数
+    static int GetMissCount() { return missCount.load(std::memory_order_relaxed); }
+
+private:
+    static AudioDeviceFormat deviceFormat; // 探测到的设备格式
+    static std::atomic<int> hitCount; // 缓存命中次数
+    static std::atomic<int> missCount; // 重新转换次数
+
+    // 源文件内容的 64 位 FNV-1a 哈希
+    static uint64_t HashData(const unsigned char* data, int size);
+    // 读取缓存文件，格式或哈希不符时返回空的 Wave
+    static Wave ReadCache(const char* cachePath, uint64_t sourceHash, AudioDeviceFormat format);
+    // 把设备格式的 Wave 写入缓存文件
+    static void WriteCache(const char* cachePath, uint64_t sourceHash, const Wave& wave);
+};
+
+#endif // SOUND_CACHE_H
@@ -0,0 +1,142 @@
+// include/SpawnGenerator.h
+#ifndef SPAWN_GENERATOR_H
+#define SPAWN_GENERATOR_H
+
+#include "raylib.h"
+#include "SpscQueue.h"
+#include "FlightPath.h"
+#include <array>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class PassabilityVerifier;
+
+// 生成的实体类型
+enum class SpawnType
+{
+    SMALL_CACTUS, // 小仙人掌
+    BIG_CACTUS, // 大仙人掌
+    BIRD // 鸟
+};
+
+// 一次生成事件
+struct SpawnEvent
+{
+    SpawnType type = SpawnType::SMALL_CACTUS; // 实体类型
+    float gapBefore = 0.0f; // 与上一个生成事件之间的滚动距离 (像素)
+    int variant = 0; // 纹理变体 (由使用者对纹理数量取模)
+    float heightFactor = 0.0f; // 鸟的高度系数：0为最高，1为贴近地面
+    FlightPath flight; // 鸟的飞行曲线
+};
+
+// 生成经过验证的分块时最终采用的结果
+enum class ChunkVerification : uint8_t
+{
+    UNVERIFIED, // 没有验证器，直接使用生成的分块
+    PASSED, // 生成的分块直接通过验证
+    REGENERATED, // 换种子重新生成后通过
+    REPAIRED, // 拉大间隔后通过
+    FALLBACK // 修复仍无法通过，换成保底分块
+};
+
+constexpr int MAX_CHUNK_EVENTS = 16; // 每个分块最多包含的生成事件数
+
+// 一段预先生成的障碍物/鸟分块
+struct SpawnChunk
+{
+    int index = -1; // 分块序号
+    float startDistance = 0.0f; // 分块开始时世界已滚动的距离
+    float length = 0.0f; // 分块覆盖的滚动距离 (所有 gapBefore 之和)
+    float difficulty = 0.0f; // 生成时使用的难度 (0.0 到 1.0)
+    int eventCount = 0; // 有效事件数量
+    std::array<SpawnEvent, MAX_CHUNK_EVENTS> events{}; // 生成事件
+};
+
+// 难度曲线与节奏配置
+struct SpawnGeneratorConfig
+{
+    float baseScrollSpeed = 200.0f; // 开局时的世界基础滚动速度
+    float scrollSpeedIncreaseRate = 10.0f; // 世界滚动速度增长率 (每秒)
+    float maxDifficultyScrollSpeed = 800.0f; // 达到满难度时的滚动速度 (约一分钟)
+    int patternsPerChunk = 4; // 每个分块包含的图案数量
+};
+
+// 生成实体的尺寸与摆放位置 (与纹理尺寸一致，验证器离线使用时不需要 GPU)
+struct SpawnGeometry
+{
+    float screenWidth = 960.0f; // 虚拟屏幕宽度
+    float screenHeight = 540.0f; // 虚拟屏幕高度
+    float groundY = 459.0f; // 地面Y坐标
+    float spawnOffsetX = 250.0f; // 实体在屏幕右边缘之外多远处生成
+    std::vector<Vector2> smallCactusSizes; // 各个小仙人掌纹理的尺寸
+    std::vector<Vector2> bigCactusSizes; // 各个大仙人掌纹理的尺寸
+    Vector2 birdSize = {0, 0}; // 鸟第一帧的尺寸
+    Vector2 dinoRunSize = {0, 0}; // 恐龙奔跑时的尺寸
+    Vector2 dinoSneakSize = {0, 0}; // 恐龙潜行时的尺寸
+    float dinoStartX = 240.0f; // 恐龙的初始X坐标
+
+    // 按高度系数计算鸟的顶部Y坐标
+    float BirdTopY(float heightFactor) const;
+    // 获取仙人掌变体的尺寸 (没有对应纹理时返回 {0, 0})
+    Vector2 CactusSize(SpawnType type, int variant) const;
+};
+
+// 基于图案的分块生成器，在后台线程提前生成分块并放入无锁队列
+class SpawnGenerator
+{
+public:
+    SpawnGenerator();
+    ~SpawnGenerator();
+
+    // 从 previousChunk 之后的分块开始 (重新) 启动后台生成
+    void Restart(const SpawnGeneratorConfig& newConfig, unsigned int newSeed,
+                 const SpawnChunk& previousChunk = SpawnChunk{});
+    // 设置即时通关验证器 (需在 Restart 之前调用)，为空时不做验证
+    void SetVerifier(std::shared_ptr<const PassabilityVerifier> newVerifier);
+    // 停止后台线程
+    void Stop();
+    // 取出下一个已生成的分块 (仅由模拟线程调用)，后台线程落后时返回 false
+    bool TryPopChunk(SpawnChunk& chunk);
+    // 获取本局的随机种子
+    unsigned int GetSeed() const { return seed; }
+    // 获取当前配置
+    const SpawnGeneratorConfig& GetConfig() const { return config; }
+
+    // 根据种子、分块序号和起始距离生成分块 (纯函数，同样的输入总是得到同样的分块)
+    static SpawnChunk BuildChunk(const SpawnGeneratorConfig& config, unsigned int seed,
+                                 int chunkIndex, float startDistance, int attempt = 0);
+    // 生成紧接 previousChunk 的分块，无法通过验证时换种子重试，仍然不行就拉大间隔修复，
+    // 修复也失败时换成保底分块；verification 不为空时写入最终采用的结果
+    static SpawnChunk BuildVerifiedChunk(const SpawnGeneratorConfig& config, unsigned int seed,
+                                         const SpawnChunk& previousChunk, const PassabilityVerifier* verifier,
+                                         ChunkVerification* verification = nullptr);
+    // 保底分块：只有一个小仙人掌，前面留出难度为0时最宽的图案间隔，总能通过
+    static SpawnChunk BuildFallbackChunk(const SpawnGeneratorConfig& config, int chunkIndex, float startDistance);
+    // 计算世界滚动到指定距离时的基础滚动速度
+    static float ScrollSpeedAtDistance(const SpawnGeneratorConfig& config, float distance);
+    // 根据滚动速度计算难度 (0.0 到 1.0)
+    static float DifficultyForSpeed(const SpawnGeneratorConfig& config, float scrollSpeed);
+
+private:
+    static constexpr size_t LOOKAHEAD_CHUNKS = 8; // 提前生成的分块数量
+    static constexpr int MAX_REGENERATE_ATTEMPTS = 4; // 验证失败时换种子重试的次数
+    static constexpr int MAX_REPAIR_ATTEMPTS = 4; // 重试仍失败时拉大间隔的次数
+    static constexpr float FALLBACK_GAP_SECONDS = 1.8f; // 保底分块的间隔 (难度为0时图案之间的最大间隔)
+
+    SpscQueue<SpawnChunk, LOOKAHEAD_CHUNKS> readyChunks; // 已生成待消费的分块
+    std::thread worker; // 后台生成线程
+    std::atomic<bool> running; // 后台线程是否运行
+    std::atomic<unsigned int> wakeCounter; // 唤醒计数，消费或停止时递增以唤醒后台线程
+    SpawnGeneratorConfig config; // 当前配置
+    unsigned int seed; // 本局随机种子
+    SpawnChunk lastBuiltChunk; // 后台线程最近生成的分块 (下一个分块紧接其后)
+    std::shared_ptr<const PassabilityVerifier> verifier; // 即时通关验证器
+
+    // 后台线程主循环
+    void WorkerLoop();
+};
+
+#endif // SPAWN_GENERATOR_H
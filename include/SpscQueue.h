@@ -0,0 +1,59 @@
+// include/SpscQueue.h
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// 单生产者单消费者无锁环形队列
+// 只允许一个线程调用 TryPush、另一个线程调用 TryPop；Clear 只能在没有其它线程访问时调用
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // 尝试放入一个元素，队列已满时返回 false
+    bool TryPush(const T& item)
+    {
+        const size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) return false;
+        slots[currentTail % Capacity] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 尝试取出一个元素，队列为空时返回 false
+    bool TryPop(T& item)
+    {
+        const size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) return false;
+        item = slots[currentHead % Capacity];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 当前元素数量 (并发时只是近似值)
+    size_t Size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    // 队列是否已满
+    bool IsFull() const { return Size() >= Capacity; }
+
+    // 清空队列
+    void Clear()
+    {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<T, Capacity> slots{}; // 元素存储
+    alignas(64) std::atomic<size_t> head; // 消费者读取位置 (独占缓存行，避免伪共享)
+    alignas(64) std::atomic<size_t> tail; // 生产者写入位置
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,62 @@
+// include/StreamingMusic.h
+#ifndef STREAMING_MUSIC_H
+#define STREAMING_MUSIC_H
+
+#include "raylib.h"
+#include "QoaDecoder.h"
+#include <cstdint>
+#include <vector>
+
+// 循环区间 (采样帧)，播放到 end 时无缝跳回 start，start 之前的部分只在开头播放一次
+struct MusicLoopPoints
+{
+    uint32_t start = 0; // 循环开始
+    uint32_t end = 0; // 循环结束 (不含)
+};
+
+// 流式背景音乐：QOA 压缩数据常驻内存，由音频线程逐块解码填充 raylib 音频流
+// 循环在解码时按采样拼接，不依赖播放时间的轮询，也没有跳转造成的空隙
+class StreamingMusic
+{
+public:
+    static constexpr unsigned int STREAM_CHUNK_FRAMES = 2048; // 每次填充的采样帧数 (音频流的一半缓冲)
+
+    StreamingMusic();
+
+    // 加载 QOA 文件并读取同名的 .loop 元数据 (主线程，音频线程启动前调用)
+    bool Load(const char* path, float volume);
+    // 卸载
+    void Unload();
+    // 是否已加载
+    bool IsLoaded() const { return loaded; }
+
+    // 以下函数只能由音频线程调用
+    // 从开头播放 (已经在播放时不做任何事)
+    void Play();
+    // 暂停
+    void Pause();
+    // 恢复
+    void Resume();
+    // 停止并回到开头
+    void Stop();
+    // 填充已经播放完的缓冲
+    void Update();
+
+    // 循环区间
+    const MusicLoopPoints& GetLoopPoints() const { return loopPoints; }
+
+private:
+    QoaDecoder decoder; // 解码器
+    AudioStream stream; // raylib 音频流
+    MusicLoopPoints loopPoints; // 循环区间
+    std::vector<int16_t> chunk; // 一次填充的采样
+    bool loaded; // 是否已加载
+    bool playing; // 是否在播放 (暂停时仍为 true)
+
+    // 解码一块采样，到循环结束处跳回循环开始
+    void FillChunk();
+    // 读取 path.loop 中的 "开始 结束" 采样帧，没有或无效时循环整首
+    static MusicLoopPoints ReadLoopPoints(const char* path, uint32_t totalFrames);
+};
+
+#endif // STREAMING_MUSIC_H
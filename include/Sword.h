@@ -4,8 +4,12 @@
 
 #include "raylib.h"
 #include "Dinosaur.h"
-#include "Bird.h"
+#include "EntityWorld.h"
 #include "ParticleSystem.h"
+#include "TextureLibrary.h"
+#include "Snapshot.h"
+#include "RenderCommandList.h"
+#include "AudioSystem.h"
 #include <vector>
 #include <cmath>
 #include "raymath.h"
@@ -15,33 +19,37 @@ class Sword
 {
 public:
     // 构造函数
-    Sword(const Texture2D& tex, const Sound& sound, Dinosaur* ownerDino);
+    Sword(TextureHandle tex, SoundHandle sound);
     // 析构函数
     ~Sword();
 
-    // 更新剑的状态和动画
-    void Update(float deltaTime);
+    // 更新剑的状态和动画 (owner 为持剑的恐龙)
+    void Update(float deltaTime, const Dinosaur& owner);
     // 绘制剑
-    void Draw() const;
+    void Draw(RenderCommandList& commands, const Dinosaur& owner) const;
     // 执行攻击动作
     void Attack();
     // 检查剑是否正在攻击状态
     bool IsAttacking() const;
-    // 检测剑与鸟群的碰撞
-    void CheckCollisionsWithBirds(std::vector<Bird>& birds, int& gameScore,
+    // 检测剑与可被击杀的实体 (SLASHABLE) 的碰撞，删除被击中的实体
+    void CheckCollisionsWithBirds(const Dinosaur& owner, EntityWorld& entities, int& gameScore,
                                   ParticleSystem& effectParticles,
                                   const ParticleProperties& effectProps,
-                                  float worldScrollSpeed, const Sound& birdScreamSound) const;
+                                  float worldScrollSpeed, SoundHandle birdScreamSound) const;
 
     // 检查剑是否在冷却中
     bool IsOnCooldown() const;
     // 获取冷却进度 (0.0 到 1.0)
     float GetCooldownProgress() const;
 
+    // 将剑的攻击与冷却状态写入快照
+    void SaveState(SnapshotWriter& writer) const;
+    // 从快照恢复剑的状态
+    void LoadState(SnapshotReader& reader);
+
 private:
-    Texture2D texture; // 剑的纹理
-    Sound swingSound; // 挥剑音效
-    Dinosaur* owner; // 剑的拥有者 (恐龙)
+    TextureHandle texture; // 剑的纹理句柄
+    SoundHandle swingSound; // 挥剑音效
 
     float cooldownTimer; // 冷却计时器
     float attackCooldown; // 攻击冷却时间
@@ -58,9 +66,9 @@ private:
     float swingEndAngleWorld; // 挥动结束时的世界角度
 
     // 获取剑的碰撞箱
-    Rectangle GetSwordAABB() const;
+    Rectangle GetSwordAABB(const Dinosaur& owner) const;
     // 获取剑在恐龙身上的附着点/旋转中心点
-    Vector2 GetAttachmentPoint() const;
+    static Vector2 GetAttachmentPoint(const Dinosaur& owner);
 };
 
 #endif // SWORD_H
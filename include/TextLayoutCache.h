@@ -0,0 +1,68 @@
+// include/TextLayoutCache.h
+#ifndef TEXT_LAYOUT_CACHE_H
+#define TEXT_LAYOUT_CACHE_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 一个字形四边形 (坐标相对文字左上角)
+struct GlyphQuad
+{
+    Rectangle source; // 字体纹理中的源矩形
+    Rectangle dest; // 相对文字左上角的目标矩形
+};
+
+// 排好版的一段文字
+struct TextLayout
+{
+    TextureHandle fontTexture = INVALID_TEXTURE; // 字体纹理句柄 (字体未登记时无效)
+    Vector2 size = {0, 0}; // 测量得到的宽高 (与 MeasureTextEx 一致)
+    std::vector<GlyphQuad> glyphs; // 预先生成的字形四边形
+};
+
+// 文字排版缓存：按 (文字, 字体, 字号, 字距) 缓存测量结果与字形四边形
+// 可以在模拟线程和渲染线程同时使用；返回的引用在 Clear 之前一直有效
+class TextLayoutCache
+{
+public:
+    // 登记字体纹理，使字形可以通过纹理库绘制 (在主线程、其它线程启动之前调用)
+    static void RegisterFont(const Font& font);
+    // 获取文字排版，首次使用时测量并生成字形
+    static const TextLayout& Get(const std::string& text, const Font& font, float fontSize, float spacing);
+    // 按 DrawText/MeasureText 的参数获取默认字体的文字排版
+    static const TextLayout& GetDefault(const std::string& text, int fontSize);
+    // 直接生成文字排版而不缓存 (用于内容经常变化的文字，复用 layout 的内存)
+    static void Build(const std::string& text, const Font& font, float fontSize, float spacing, TextLayout& layout);
+    // 按 DrawText 的参数生成默认字体的文字排版而不缓存
+    static void BuildDefault(const std::string& text, int fontSize, TextLayout& layout);
+    // 清空缓存与登记的字体 (此后之前返回的引用全部失效)
+    static void Clear();
+
+private:
+    // 缓存键
+    struct Key
+    {
+        std::string text; // 文字
+        unsigned int fontTextureId; // 字体纹理
+        float fontSize; // 字号
+        float spacing; // 字距
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    // 缓存键的哈希
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    static std::mutex mutex; // 保护下面的成员
+    static std::unordered_map<Key, TextLayout, KeyHash> layouts; // 已缓存的排版
+    static std::unordered_map<unsigned int, TextureHandle> fontTextures; // 字体纹理 ID -> 纹理句柄
+};
+
+#endif // TEXT_LAYOUT_CACHE_H
@@ -0,0 +1,49 @@
+// include/TextureLibrary.h
+#ifndef TEXTURE_LIBRARY_H
+#define TEXTURE_LIBRARY_H
+
+#include "raylib.h"
+#include <vector>
+#include <string>
+
+// 纹理句柄：纹理库中的下标，实体只保存句柄而不保存 Texture2D
+using TextureHandle = int;
+constexpr TextureHandle INVALID_TEXTURE = -1;
+
+// 一组连续加载的纹理 (如动画帧、同类仙人掌)
+struct TextureGroup
+{
+    TextureHandle first = INVALID_TEXTURE; // 第一张纹理的句柄
+    int count = 0; // 纹理数量
+
+    bool empty() const { return count <= 0; }
+    int size() const { return count; }
+    TextureHandle operator[](const int index) const { return first + index; }
+};
+
+// 全局纹理库，统一持有所有已加载的纹理
+class TextureLibrary
+{
+public:
+    // 加载单张纹理 (点过滤)，加载失败时也会占用一个句柄，保证同组句柄连续
+    static TextureHandle Load(const char* path);
+    // 从内存中的图片创建纹理 (点过滤)，由纹理库负责卸载
+    static TextureHandle LoadFromImage(const Image& image);
+    // 按顺序加载一组纹理
+    static TextureGroup LoadGroup(const std::vector<std::string>& paths);
+    // 登记一张由调用者负责卸载的纹理 (如渲染纹理)，使其可以通过句柄绘制
+    static TextureHandle Register(const Texture2D& texture);
+    // 通过句柄获取纹理，无效句柄返回空纹理
+    static const Texture2D& Get(TextureHandle handle);
+    // 卸载所有纹理 (登记的外部纹理只移除不卸载)
+    static void UnloadAll();
+    // 用新图片替换从 path 加载的纹理，句柄不变 (主线程，模拟线程暂停时调用)，返回替换的纹理数
+    static int Reload(const std::string& path, const Image& image);
+
+private:
+    static std::vector<Texture2D> textures; // 所有纹理
+    static std::vector<bool> owned; // 各纹理是否由纹理库负责卸载
+    static std::vector<std::string> paths; // 各纹理的文件路径 (不是从文件加载的为空)
+};
+
+#endif // TEXTURE_LIBRARY_H
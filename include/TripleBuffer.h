@@ -0,0 +1,46 @@
+// include/TripleBuffer.h
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+
+// 单写者单读者无锁三缓冲
+// 写者总是写入自己独占的后缓冲并发布，读者总是读取最近一次发布的完整数据，两边互不等待
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : middle(1), back(2), front(0) {}
+
+    // 获取写者独占的后缓冲 (仅由写线程调用)
+    T& WriteBuffer() { return slots[back]; }
+
+    // 发布后缓冲中的内容，并换回一个可写的缓冲 (仅由写线程调用)
+    void Publish()
+    {
+        back = middle.exchange(back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // 如果有新发布的内容就换到读缓冲，返回是否取到了新内容 (仅由读线程调用)
+    bool AcquireLatest()
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // 获取读线程当前持有的缓冲 (仅由读线程调用)
+    const T& ReadBuffer() const { return slots[front]; }
+
+private:
+    static constexpr unsigned int FRESH_BIT = 4; // 中间缓冲含有读者尚未取走的新内容
+    static constexpr unsigned int INDEX_MASK = 3; // 缓冲序号部分
+
+    std::array<T, 3> slots{}; // 三个缓冲
+    alignas(64) std::atomic<unsigned int> middle; // 中间缓冲序号 (带新内容标记)，两个线程通过它交换缓冲
+    alignas(64) unsigned int back; // 写者持有的缓冲序号
+    alignas(64) unsigned int front; // 读者持有的缓冲序号
+};
+
+#endif // TRIPLE_BUFFER_H
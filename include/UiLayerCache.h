@@ -0,0 +1,81 @@
+// include/UiLayerCache.h
+#ifndef UI_LAYER_CACHE_H
+#define UI_LAYER_CACHE_H
+
+#include "raylib.h"
+#include "TextureLibrary.h"
+#include <array>
+
+// 菜单按钮
+enum class MenuButton
+{
+    NONE = -1, // 没有按钮
+    RESTART, // 重新开始
+    QUIT // 退出游戏
+};
+
+// 单个按钮的布局
+struct MenuButtonLayout
+{
+    Rectangle rect; // 按钮区域
+    const char* text; // 按钮文字
+    int textX, textY; // 文字左上角
+};
+
+// 菜单界面的布局：只在启动时计算一次，点击检测和绘制共用同一份数据
+struct MenuLayout
+{
+    const char* title = "Dino Plus Ultra"; // 暂停界面标题
+    int titleFontSize = 60; // 标题字号
+    int titleX = 0, titleY = 0; // 标题左上角
+    int buttonFontSize = 25; // 按钮字号
+    std::array<MenuButtonLayout, 2> buttons{}; // 按 MenuButton 顺序排列的按钮
+    const char* gameOverText = "GAME OVER"; // 游戏结束标题
+    int gameOverFontSize = 70; // 游戏结束标题字号
+    int gameOverX = 0, gameOverY = 0; // 游戏结束标题左上角
+    const char* restartHintText = "Press R to Restart"; // 重新开始提示
+    int restartHintFontSize = 25; // 提示字号
+    int restartHintX = 0, restartHintY = 0; // 提示左上角
+
+    // 按虚拟屏幕尺寸计算布局 (需要默认字体，窗口创建后调用)
+    static MenuLayout Compute(int virtualWidth, int virtualHeight);
+    // 返回虚拟屏幕坐标下的按钮
+    MenuButton HitTest(Vector2 virtualPos) const;
+};
+
+// 菜单界面缓存：静态内容只渲染一次到渲染纹理，暂停界面只在悬停按钮改变时重绘
+class UiLayerCache
+{
+public:
+    UiLayerCache();
+
+    // 创建渲染纹理并渲染游戏结束界面 (窗口创建后、在任何 BeginTextureMode 之外调用)
+    void Initialize(const MenuLayout& menuLayout, int virtualWidth, int virtualHeight);
+    // 释放渲染纹理
+    void Unload();
+    // 悬停按钮改变时重绘暂停界面 (在任何 BeginTextureMode 之外调用)
+    void UpdatePauseLayer(MenuButton hovered);
+
+    // 暂停界面缓存的纹理句柄
+    TextureHandle GetPauseLayer() const { return pauseHandle; }
+    // 游戏结束界面缓存的纹理句柄
+    TextureHandle GetGameOverLayer() const { return gameOverHandle; }
+    // 缓存纹理的源矩形 (渲染纹理上下颠倒)
+    Rectangle GetSourceRect() const;
+    // 暂停界面的缓存是否就是给定悬停按钮的样子 (不需要重绘)
+    bool IsPauseLayerCurrent(const MenuButton hovered) const { return pauseLayerValid && hovered == cachedHover; }
+    // 暂停界面自创建以来重绘的次数
+    int GetPauseRedrawCount() const { return pauseRedrawCount; }
+
+private:
+    MenuLayout layout; // 菜单布局
+    RenderTexture2D pauseLayer; // 暂停界面 (标题与按钮)
+    RenderTexture2D gameOverLayer; // 游戏结束界面
+    TextureHandle pauseHandle; // 暂停界面的纹理句柄
+    TextureHandle gameOverHandle; // 游戏结束界面的纹理句柄
+    MenuButton cachedHover; // 暂停界面缓存时的悬停按钮
+    bool pauseLayerValid; // 暂停界面缓存是否有效
+    int pauseRedrawCount; // 暂停界面重绘次数
+};
+
+#endif // UI_LAYER_CACHE_H
@@ -10,25 +10,39 @@
 //     return min + (static_cast<float>(rand()) / static_cast<float>(RAND_MAX)) * (max - min);
 // }
 
+// 获取当前线程的随机数生成器 (世界快照会保存/恢复它的状态)
+inline std::mt19937& RandomEngine()
+{
+    // 线程局部静态变量，确保每个线程有自己的生成器实例
+    thread_local std::mt19937 generator(std::random_device{}());
+    return generator;
+}
+
 // 生成 [min, max] 范围内的随机浮点数 (如果 min >= max, 返回 min)
 inline float randF(const float min, const float max)
 {
     if (min >= max) return min;
-    // 线程局部静态变量，确保每个线程有自己的生成器实例
-    thread_local std::mt19937 generator(std::random_device{}());
     std::uniform_real_distribution<float> distribution(min, max);
-    return distribution(generator);
+    return distribution(RandomEngine());
 }
 
 // 生成 [min, max-1] 范围内的随机整数 (如果 min >= max, 返回 min)
 inline int randI(const int min, const int max)
 {
     if (min >= max) return min;
-    // 线程局部静态变量
-    thread_local std::mt19937 generator(std::random_device{}());
     // 分布范围是 [min, max-1]
     std::uniform_int_distribution<int> distribution(min, max - 1);
-    return distribution(generator);
+    return distribution(RandomEngine());
+}
+
+// 批量生成 [0, 1) 范围内的随机浮点数：直接取生成器输出的高 24 位，不为每个数构造分布对象
+inline void randUnitFloats(float* values, const int count)
+{
+    std::mt19937& engine = RandomEngine();
+    for (int i = 0; i < count; ++i)
+    {
+        values[i] = static_cast<float>(engine() >> 8) * (1.0f / 16777216.0f);
+    }
 }
 
 // std::mt19937 是梅森旋转算法，随机性和周期都远好于 rand()。
@@ -0,0 +1,54 @@
+// src/AnimationClip.cpp
+#include "../include/AnimationClip.h"
+#include <cmath>
+
+std::vector<AnimationClip> AnimationLibrary::clips;
+
+// 播放时间换算成帧下标，负的时间视为还没开始 (第一帧)
+int AnimationClip::FrameAt(const float time) const
+{
+    const int count = frames.size();
+    if (count <= 1 || frameDuration <= 0.0f || time <= 0.0f) return 0;
+    const auto step = static_cast<long long>(std::floor(time / frameDuration));
+    switch (loop)
+    {
+    case AnimationLoop::ONCE:
+        return step >= count ? count - 1 : static_cast<int>(step);
+    case AnimationLoop::PING_PONG:
+        {
+            // 一个往返是 2 * (count - 1) 步，首尾两帧不重复
+            const long long period = 2LL * (count - 1);
+            const auto phase = static_cast<int>(step % period);
+            return phase < count ? phase : static_cast<int>(period) - phase;
+        }
+    default:
+        return static_cast<int>(step % count);
+    }
+}
+
+TextureHandle AnimationClip::Sample(const float time) const
+{
+    if (frames.empty()) return INVALID_TEXTURE;
+    return frames[FrameAt(time)];
+}
+
+AnimationClipId AnimationLibrary::Add(const AnimationClip& clip)
+{
+    clips.push_back(clip);
+    return static_cast<AnimationClipId>(clips.size()) - 1;
+}
+
+const AnimationClip& AnimationLibrary::Get(const AnimationClipId id)
+{
+    static const AnimationClip emptyClip{};
+    if (id < 0 || id >= static_cast<AnimationClipId>(clips.size()))
+    {
+        return emptyClip;
+    }
+    return clips[id];
+}
+
+void AnimationLibrary::Clear()
+{
+    clips.clear();
+}
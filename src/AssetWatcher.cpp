@@ -0,0 +1,165 @@
+// src/AssetWatcher.cpp
+#include "../include/AssetWatcher.h"
+#include "../include/SoundCache.h"
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+AssetWatcher::AssetWatcher() : inotifyFd(-1), wakeFd(-1), hasPending(false)
+{
+}
+
+AssetWatcher::~AssetWatcher()
+{
+    Stop();
+}
+
+// 开始监视目录及其子目录
+bool AssetWatcher::Start(const char* rootDirectory)
+{
+#ifdef __linux__
+    Stop();
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0)
+    {
+        Stop();
+        return false;
+    }
+    SoundCache::GetDeviceFormat(); // 在主线程先探测设备格式，监视线程只读取
+    AddWatches(rootDirectory);
+    watchThread = std::thread(&AssetWatcher::WatchLoop, this);
+    return true;
+#else
+    (void)rootDirectory;
+    return false;
+#endif
+}
+
+// 停止并等待监视线程，丢弃还没替换的资源
+void AssetWatcher::Stop()
+{
+#ifdef __linux__
+    if (watchThread.joinable())
+    {
+        const uint64_t one = 1;
+        (void)write(wakeFd, &one, sizeof(one));
+        watchThread.join();
+    }
+    if (inotifyFd >= 0) close(inotifyFd);
+    if (wakeFd >= 0) close(wakeFd);
+#endif
+    inotifyFd = -1;
+    wakeFd = -1;
+    watchedDirectories.clear();
+    for (auto& asset : TakePending()) Release(asset);
+}
+
+// 取出所有等待替换的资源
+std::vector<ReloadedAsset> AssetWatcher::TakePending()
+{
+    std::lock_guard lock(pendingMutex);
+    hasPending.store(false, std::memory_order_relaxed);
+    return std::move(pending);
+}
+
+// 监视目录及其所有子目录 (inotify 不递归)
+void AssetWatcher::AddWatches(const std::string& directory)
+{
+#ifdef __linux__
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) return;
+    const int watch = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (watch >= 0) watchedDirectories[watch] = directory;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.is_directory(error)) AddWatches(entry.path().generic_string());
+    }
+#else
+    (void)directory;
+#endif
+}
+
+// 监视线程主循环：阻塞在 poll 上，文件写完 (或被替换) 时才醒来
+void AssetWatcher::WatchLoop()
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+    while (true)
+    {
+        if (poll(fds, 2, -1) < 0) continue;
+        if (fds[1].revents & POLLIN) break;
+
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                const auto directory = watchedDirectories.find(event->wd);
+                if (event->len == 0 || directory == watchedDirectories.end()) continue;
+
+                const std::string path = directory->second + "/" + event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) AddWatches(path);
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    ReloadFile(path);
+                }
+            }
+        }
+    }
+#endif
+}
+
+// 重新解码被修改的文件；同一文件连续保存时只保留最新的一份
+void AssetWatcher::ReloadFile(const std::string& path)
+{
+    ReloadedAsset asset{path, AssetKind::TEXTURE, Image{}, Wave{}};
+    if (IsFileExtension(path.c_str(), ".png"))
+    {
+        asset.image = LoadImage(path.c_str());
+        if (asset.image.data == nullptr) return;
+    }
+    else if (IsFileExtension(path.c_str(), ".wav"))
+    {
+        asset.kind = AssetKind::SOUND;
+        asset.wave = SoundCache::LoadWave(path.c_str());
+        if (asset.wave.frameCount == 0) return;
+    }
+    else
+    {
+        return;
+    }
+
+    std::lock_guard lock(pendingMutex);
+    for (auto& existing : pending)
+    {
+        if (existing.path == path)
+        {
+            Release(existing);
+            existing = asset;
+            return;
+        }
+    }
+    pending.push_back(asset);
+    hasPending.store(true, std::memory_order_release);
+}
+
+// 释放一个资源的图片或波形
+void AssetWatcher::Release(ReloadedAsset& asset)
+{
+    if (asset.image.data != nullptr) UnloadImage(asset.image);
+    if (asset.wave.data != nullptr) UnloadWave(asset.wave);
+    asset.image = Image{};
+    asset.wave = Wave{};
+}
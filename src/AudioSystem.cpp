@@ -0,0 +1,291 @@
+// src/AudioSystem.cpp
+#include "../include/AudioSystem.h"
+#include "../include/SoundCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+std::vector<AudioSystem::SoundEntry> AudioSystem::sounds;
+std::vector<AudioSystem::Voice> AudioSystem::voices;
+int AudioSystem::voiceBudget = DEFAULT_VOICE_BUDGET;
+uint64_t AudioSystem::nextStartOrder = 0;
+StreamingMusic AudioSystem::music;
+SpscQueue<AudioCommand, AudioSystem::COMMAND_QUEUE_SIZE> AudioSystem::commands;
+std::thread AudioSystem::audioThread;
+std::atomic<bool> AudioSystem::running(false);
+std::atomic<uint32_t> AudioSystem::droppedCommands(0);
+std::atomic<uint32_t> AudioSystem::stolenVoices(0);
+std::atomic<uint32_t> AudioSystem::rejectedVoices(0);
+uint32_t AudioSystem::currentTick = 0;
+std::mutex AudioSystem::reloadMutex;
+std::vector<std::pair<std::string, Wave>> AudioSystem::pendingReloads;
+std::atomic<bool> AudioSystem::reloadPending(false);
+
+// 加载音效，加载失败时也保留发声的位置，之后热重载可以补上
+SoundHandle AudioSystem::LoadSound(const char* path, const SoundSettings& settings)
+{
+    const int voiceCount = std::max(settings.maxVoices, 1);
+    SoundEntry entry{path, settings, static_cast<int>(voices.size()), voiceCount, 0, 0};
+    entry.settings.maxVoices = voiceCount;
+    voices.resize(voices.size() + voiceCount);
+    CreateVoices(entry, SoundCache::Load(path));
+    sounds.push_back(entry);
+    return static_cast<SoundHandle>(sounds.size()) - 1;
+}
+
+// 为音效创建发声：第一个使用音效本身，其余是共享采样数据的别名
+void AudioSystem::CreateVoices(SoundEntry& entry, const Sound& source)
+{
+    if (source.frameCount == 0) return;
+    voices[entry.firstVoice] = {source, false, 0};
+    for (int i = 1; i < entry.voiceCount; ++i)
+    {
+        voices[entry.firstVoice + i] = {LoadSoundAlias(source), true, 0};
+    }
+}
+
+// 卸载音效的所有发声，别名不拥有采样数据，必须在音效本身之前卸载
+void AudioSystem::DestroyVoices(const SoundEntry& entry)
+{
+    for (int i = entry.voiceCount - 1; i >= 0; --i)
+    {
+        Voice& voice = voices[entry.firstVoice + i];
+        if (voice.sound.frameCount > 0)
+        {
+            if (voice.alias) UnloadSoundAlias(voice.sound);
+            else UnloadSound(voice.sound);
+        }
+        voice = Voice{};
+    }
+}
+
+bool AudioSystem::LoadMusic(const char* path, const float volume)
+{
+    return music.Load(path, volume);
+}
+
+// 启动音频线程
+void AudioSystem::Start()
+{
+    if (running.exchange(true)) return;
+    audioThread = std::thread(&AudioSystem::AudioLoop);
+}
+
+// 停止并等待音频线程
+void AudioSystem::Stop()
+{
+    running.store(false);
+    if (audioThread.joinable())
+    {
+        audioThread.join();
+    }
+    AudioCommand discarded{};
+    while (commands.TryPop(discarded))
+    {
+    }
+    std::lock_guard lock(reloadMutex);
+    for (auto& reload : pendingReloads) UnloadWave(reload.second);
+    pendingReloads.clear();
+    reloadPending.store(false);
+}
+
+void AudioSystem::UnloadAll()
+{
+    for (const SoundEntry& entry : sounds)
+    {
+        DestroyVoices(entry);
+    }
+    voices.clear();
+    sounds.clear();
+    music.Unload();
+}
+
+// 设置同时发声的总数
+void AudioSystem::SetVoiceBudget(const int newBudget)
+{
+    voiceBudget = std::max(newBudget, 1);
+}
+
+// 放入等待替换的音效，音频线程下一轮替换
+void AudioSystem::QueueReload(const std::string& path, const Wave& wave)
+{
+    std::lock_guard lock(reloadMutex);
+    pendingReloads.emplace_back(path, wave);
+    reloadPending.store(true, std::memory_order_release);
+}
+
+// 替换等待中的音效：句柄和发声位置不变，正在播放的发声被停止
+void AudioSystem::ApplyReloads()
+{
+    std::vector<std::pair<std::string, Wave>> reloads;
+    {
+        std::lock_guard lock(reloadMutex);
+        reloads.swap(pendingReloads);
+        reloadPending.store(false, std::memory_order_relaxed);
+    }
+    for (auto& [path, wave] : reloads)
+    {
+        for (SoundEntry& entry : sounds)
+        {
+            if (entry.path != path) continue;
+            DestroyVoices(entry);
+            CreateVoices(entry, LoadSoundFromWave(wave));
+        }
+        UnloadWave(wave);
+    }
+}
+
+// 开始新的一步
+void AudioSystem::BeginTick()
+{
+    ++currentTick;
+}
+
+// 放入一条命令，队列满时丢弃 (音效晚到比阻塞游戏逻辑更糟)
+void AudioSystem::Push(const AudioCommandType type, const SoundHandle sound)
+{
+    if (!commands.TryPush({type, sound, currentTick}))
+    {
+        droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioSystem::Play(const SoundHandle sound)
+{
+    if (sound != INVALID_SOUND) Push(AudioCommandType::PLAY_SOUND, sound);
+}
+
+void AudioSystem::PlayMusic()
+{
+    Push(AudioCommandType::PLAY_MUSIC, INVALID_SOUND);
+}
+
+void AudioSystem::PauseMusic()
+{
+    Push(AudioCommandType::PAUSE_MUSIC, INVALID_SOUND);
+}
+
+void AudioSystem::ResumeMusic()
+{
+    Push(AudioCommandType::RESUME_MUSIC, INVALID_SOUND);
+}
+
+void AudioSystem::StopMusic()
+{
+    Push(AudioCommandType::STOP_MUSIC, INVALID_SOUND);
+}
+
+// 执行一条命令
+void AudioSystem::Execute(const AudioCommand& command)
+{
+    switch (command.type)
+    {
+    case AudioCommandType::PLAY_SOUND:
+        {
+            if (command.sound < 0 || command.sound >= static_cast<SoundHandle>(sounds.size())) return;
+            SoundEntry& entry = sounds[command.sound];
+            const int voiceIndex = AcquireVoice(command.sound);
+            if (voiceIndex < 0) return;
+
+            // 同一步内叠加的相同音效 (如一次挥剑同时命中几只鸟) 逐个降低音量，叠加后不至于爆音
+            if (entry.lastTick != command.tick)
+            {
+                entry.lastTick = command.tick;
+                entry.playsInTick = 0;
+            }
+            const float layerGain = 1.0f / std::sqrt(static_cast<float>(++entry.playsInTick));
+            Voice& voice = voices[voiceIndex];
+            voice.startOrder = nextStartOrder++;
+            SetSoundVolume(voice.sound, entry.settings.volume * layerGain);
+            ::PlaySound(voice.sound);
+        }
+        break;
+    case AudioCommandType::PLAY_MUSIC:
+        music.Play();
+        break;
+    case AudioCommandType::PAUSE_MUSIC:
+        music.Pause();
+        break;
+    case AudioCommandType::RESUME_MUSIC:
+        music.Resume();
+        break;
+    case AudioCommandType::STOP_MUSIC:
+        music.Stop();
+        break;
+    }
+}
+
+// 为音效选一个发声：
+// 1. 音效自己有空闲的发声且总发声数没有超出预算时直接使用
+// 2. 音效的发声都在播放时重新开始其中最早的一个 (总数不变)
+// 3. 总发声数用完时抢占优先级最低 (相同时最早) 的发声，它的优先级高于新音效时放弃播放
+int AudioSystem::AcquireVoice(const SoundHandle sound)
+{
+    const SoundEntry& entry = sounds[sound];
+    if (voices[entry.firstVoice].sound.frameCount == 0) return -1;
+
+    int freeVoice = -1;
+    int oldestOwnVoice = entry.firstVoice;
+    for (int i = entry.firstVoice; i < entry.firstVoice + entry.voiceCount; ++i)
+    {
+        if (!IsSoundPlaying(voices[i].sound))
+        {
+            freeVoice = i;
+            break;
+        }
+        if (voices[i].startOrder < voices[oldestOwnVoice].startOrder) oldestOwnVoice = i;
+    }
+    if (freeVoice < 0)
+    {
+        StopSound(voices[oldestOwnVoice].sound);
+        stolenVoices.fetch_add(1, std::memory_order_relaxed);
+        return oldestOwnVoice;
+    }
+
+    int activeVoices = 0;
+    int victim = -1;
+    int victimPriority = 0;
+    for (const SoundEntry& other : sounds)
+    {
+        for (int i = other.firstVoice; i < other.firstVoice + other.voiceCount; ++i)
+        {
+            if (!IsSoundPlaying(voices[i].sound)) continue;
+            ++activeVoices;
+            if (victim < 0 || other.settings.priority < victimPriority ||
+                (other.settings.priority == victimPriority && voices[i].startOrder < voices[victim].startOrder))
+            {
+                victim = i;
+                victimPriority = other.settings.priority;
+            }
+        }
+    }
+    if (activeVoices < voiceBudget) return freeVoice;
+    if (victimPriority > entry.settings.priority)
+    {
+        rejectedVoices.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+    StopSound(voices[victim].sound);
+    stolenVoices.fetch_add(1, std::memory_order_relaxed);
+    return freeVoice;
+}
+
+// 音频线程主循环：按固定间隔处理命令并解码填充音乐流，游戏逻辑和渲染卡顿都不会让音乐断流
+void AudioSystem::AudioLoop()
+{
+    const auto interval = std::chrono::milliseconds(UPDATE_INTERVAL_MS);
+    auto nextUpdate = std::chrono::steady_clock::now();
+    while (running.load())
+    {
+        AudioCommand command{};
+        while (commands.TryPop(command))
+        {
+            Execute(command);
+        }
+        if (reloadPending.load(std::memory_order_acquire)) ApplyReloads();
+        if (IsAudioDeviceReady()) music.Update();
+
+        nextUpdate = std::max(nextUpdate + interval, std::chrono::steady_clock::now());
+        std::this_thread::sleep_until(nextUpdate);
+    }
+}
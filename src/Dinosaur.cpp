@@ -2,33 +2,26 @@
 #include "../include/Dinosaur.h"
 
 Dinosaur::Dinosaur(const float startX, const float groundY,
-                   const std::vector<Texture2D>& runTex,
-                   const std::vector<Texture2D>& sneakTex,
-                   const Texture2D& deadTex,
-                   const Sound& jumpSound,
-                   const Sound& dashSound)
+                   const AnimationClipId runClip,
+                   const AnimationClipId sneakClip,
+                   const TextureHandle deadTex,
+                   const SoundHandle jumpSound,
+                   const SoundHandle dashSound)
     : position({0, 0}), velocity({0, 0}), groundY(groundY), runHeight(0.0f),
       sneakHeight(0.0f), jumpSoundHandle(jumpSound), dashSoundHandle(dashSound),
       isJumping(false), isSneaking(false), facingRight(true),
-      runFrames(runTex), sneakFrames(sneakTex), deadTexture(deadTex),
-      isDead(false), currentAnimFrameIndex(0), frameTimeCounter(0.0f),
-      animationSpeed(0.08f), collisionRect({0, 0, 0, 0}),
-      gravity(1800.0f), jumpSpeed(-600.0f),
+      runClip(runClip), sneakClip(sneakClip), deadTexture(deadTex),
+      isDead(false), collisionRect({0, 0, 0, 0}),
       jumpBufferDuration(0.1f), jumpBufferCounter(0.0f),
       jumpQueued(false),
-      sneakGravityMultiplier(2.5f),
-      moveSpeed(280.0f),
+      movement(),
       isDashing(false),
-      dashSpeedMagnitude(800.0f),
-      dashDuration(0.18f),
       dashTimer(0.0f),
-      dashCooldown(0.5f),
       dashCooldownTimer(0.0f),
-      dashDirection({0.0f, 0.0f}),
-      dashTrailParticles(150)
+      dashDirection({0.0f, 0.0f})
 {
-    runHeight = static_cast<float>(runFrames[0].height);
-    sneakHeight = static_cast<float>(sneakFrames[0].height);
+    runHeight = static_cast<float>(TextureLibrary::Get(AnimationLibrary::Get(runClip).Sample(0.0f)).height);
+    sneakHeight = static_cast<float>(TextureLibrary::Get(AnimationLibrary::Get(sneakClip).Sample(0.0f)).height);
     position = {startX, groundY - runHeight};
     // 更新碰撞矩形
     UpdateCollisionRect();
@@ -46,7 +39,6 @@ Dinosaur::Dinosaur(const float startX, const float groundY,
     dashParticleProps.gravityScaleMin = 0.1f;
     dashParticleProps.gravityScaleMax = 0.5f;
     dashParticleProps.targetGroundY = groundY + 5.0f;
-    dashTrailParticles.SetGravity({0, gravity});
 }
 
 Dinosaur::~Dinosaur() = default;
@@ -69,14 +61,17 @@ void Dinosaur::RequestDash()
     }
     isDashing = true;
     dashTimer = 0.0f; // 重置冲刺计时器
-    dashCooldownTimer = dashCooldown; // 开始冲刺冷却
+    dashCooldownTimer = movement.dashCooldown; // 开始冲刺冷却
     dashDirection.x = facingRight ? 1.0f : -1.0f; // 根据朝向设置冲刺方向
     dashDirection.y = 0.0f;
-    PlaySound(dashSoundHandle);
+    // 拖尾粒子向冲刺的反方向飞散，整个冲刺期间不变
+    dashParticleProps.emissionAngleMin = dashDirection.x > 0 ? 100.0f : 10.0f;
+    dashParticleProps.emissionAngleMax = dashDirection.x > 0 ? 170.0f : 80.0f;
+    AudioSystem::Play(dashSoundHandle);
 }
 
 // 更新恐龙状态，每帧调用
-void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed)
+void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed, ParticleSystem& dashTrail)
 {
     // 如果恐龙已死亡
     if (isDead)
@@ -84,17 +79,17 @@ void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed)
         // 如果不在地面上，施加重力
         if (!IsOnGround())
         {
-            velocity.y += gravity * deltaTime;
+            velocity.y += movement.gravity * deltaTime;
         }
         position.y += velocity.y * deltaTime; // 更新Y轴位置
         // 如果接触地面
         if (IsOnGround())
         {
-            position.y = (groundY - GetHeight()) + 5.0f;
+            position.y = (groundY - GetHeight()) + movement.groundTolerance;
             velocity.y = 0;
         }
         UpdateCollisionRect(); // 更新碰撞矩形
-        dashTrailParticles.Update(deltaTime);
+        dashTrail.Update(deltaTime);
         return;
     }
 
@@ -108,38 +103,21 @@ void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed)
     if (isDashing)
     {
         dashTimer += deltaTime; // 增加冲刺时间
-        if (dashTimer >= dashDuration) // 如果冲刺时间结束
+        if (dashTimer >= movement.dashDuration) // 如果冲刺时间结束
         {
             isDashing = false; // 结束冲刺状态
         }
         else
         {
             // 更新X轴位置实现冲刺移动
-            position.x += dashDirection.x * dashSpeedMagnitude * deltaTime;
-            // 发射冲刺拖尾粒子
-            const int particlesToEmit = randI(2, 4); // 随机发射
-            for (int i = 0; i < particlesToEmit; ++i)
-            {
-                const float dinoWidth = GetWidth();
-                const float dinoHeight = GetHeight();
-                // 在恐龙身体范围内随机位置发射粒子
-                const Vector2 particleEmitPos = {
-                    position.x + randF(dinoWidth * 0.1f, dinoWidth * 0.9f),
-                    position.y + randF(dinoHeight * 0.1f, dinoHeight * 0.9f)
-                };
-                // 根据冲刺方向设置粒子发射角度，使其向后飞散
-                if (dashDirection.x > 0) // 向右冲刺
-                {
-                    dashParticleProps.emissionAngleMin = 100.0f;
-                    dashParticleProps.emissionAngleMax = 170.0f;
-                }
-                else
-                {
-                    dashParticleProps.emissionAngleMin = 10.0f;
-                    dashParticleProps.emissionAngleMax = 80.0f;
-                }
-                dashTrailParticles.Emit(particleEmitPos, 1, dashParticleProps, worldScrollSpeed);
-            }
+            position.x += dashDirection.x * movement.dashSpeedMagnitude * deltaTime;
+            // 在恐龙身体范围内随机位置一次发射一批冲刺拖尾粒子
+            const float dinoWidth = GetWidth();
+            const float dinoHeight = GetHeight();
+            const Rectangle emitArea = {
+                position.x + dinoWidth * 0.1f, position.y + dinoHeight * 0.1f, dinoWidth * 0.8f, dinoHeight * 0.8f
+            };
+            dashTrail.EmitInArea(emitArea, randI(2, 4), dashParticleProps, worldScrollSpeed);
         }
     }
 
@@ -157,11 +135,11 @@ void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed)
         }
 
         // 计算当前有效的重力
-        float currentEffectiveGravity = gravity;
+        float currentEffectiveGravity = movement.gravity;
         // 如果在潜行且不在地面，增加重力使其下落更快
         if (isSneaking && !IsOnGround())
         {
-            currentEffectiveGravity *= sneakGravityMultiplier;
+            currentEffectiveGravity *= movement.sneakGravityMultiplier;
         }
         // 如果不在地面，施加重力
         if (!IsOnGround())
@@ -178,7 +156,7 @@ void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed)
         if (velocity.y >= 0) // 确保是向下运动时触地
         {
             velocity.y = 0;
-            position.y = (groundY - GetHeight()) + 5.0f; // 精确设置在地面上
+            position.y = (groundY - GetHeight()) + movement.groundTolerance; // 精确设置在地面上
             if (isJumping) // 如果之前在跳跃状态
             {
                 isJumping = false; // 结束跳跃状态
@@ -195,58 +173,25 @@ void Dinosaur::Update(const float deltaTime, const float worldScrollSpeed)
         isJumping = true; // 标记为跳跃状态 (或空中状态)
     }
 
-    // 更新动画帧
-    if (const std::vector<Texture2D>* currentFrames = GetCurrentAnimationFramesPointer(); currentFrames && !
-        currentFrames->empty()) // 获取当前状态的动画帧组
-    {
-        if (isJumping && !isDashing)
-        {
-            currentAnimFrameIndex = 0;
-        }
-        else if (isDashing)
-        {
-            currentAnimFrameIndex = 0;
-        }
-        else
-        {
-            frameTimeCounter += deltaTime;
-            if (frameTimeCounter >= animationSpeed)
-            {
-                frameTimeCounter = 0.0f;
-                currentAnimFrameIndex++;
-                if (currentAnimFrameIndex >= currentFrames->size())
-                {
-                    currentAnimFrameIndex = 0; // 循环播放
-                }
-            }
-        }
-    }
-    else
-    {
-        currentAnimFrameIndex = 0;
-    }
-
     // 更新碰撞矩形
     UpdateCollisionRect();
     // 更新冲刺粒子系统
-    dashTrailParticles.Update(deltaTime);
+    dashTrail.Update(deltaTime);
 }
 
 // 绘制恐龙
-void Dinosaur::Draw() const
+void Dinosaur::Draw(RenderCommandList& commands, const float animationTime) const
 {
-    dashTrailParticles.Draw();
-    const Texture2D texToDraw = GetCurrentTextureToDraw(); // 获取当前应绘制的纹理
+    const TextureHandle texHandle = GetCurrentTextureHandle(animationTime); // 获取当前应绘制的纹理
+    const auto [texWidth, texHeight] = commands.GetTextureSize(texHandle);
     // 定义源矩形 (纹理的哪个部分被绘制)
-    Rectangle sourceRec = {0.0f, 0.0f, static_cast<float>(texToDraw.width), static_cast<float>(texToDraw.height)};
+    Rectangle sourceRec = {0.0f, 0.0f, texWidth, texHeight};
     // 如果恐龙朝左，则水平翻转源矩形
     if (!facingRight) sourceRec.width *= -1;
     // 定义目标矩形 (在屏幕上的绘制位置和大小)
-    const Rectangle destRec = {
-        position.x, position.y, static_cast<float>(std::abs(texToDraw.width)), static_cast<float>(texToDraw.height)
-    };
+    const Rectangle destRec = {position.x, position.y, std::abs(texWidth), texHeight};
     constexpr Vector2 origin = {0.0f, 0.0f}; // 旋转和缩放的原点 (左上角)
-    DrawTexturePro(texToDraw, sourceRec, destRec, origin, 0.0f, WHITE);
+    commands.AddTexture(RenderLayer::PLAYER, texHandle, sourceRec, destRec, origin, 0.0f, WHITE);
 }
 
 // 控制恐龙左右移动
@@ -254,7 +199,7 @@ void Dinosaur::Move(const float direction, const float deltaTime)
 {
     if (isDashing || isDead) return;
 
-    float currentMoveSpeed = moveSpeed;
+    float currentMoveSpeed = movement.moveSpeed;
     // 如果在潜行，移动速度减半
     if (isSneaking) { currentMoveSpeed *= 0.5f; }
     // 根据方向、速度和时间差更新X轴位置
@@ -268,7 +213,7 @@ void Dinosaur::Move(const float direction, const float deltaTime)
 // 检查恐龙是否在地面上
 bool Dinosaur::IsOnGround() const
 {
-    return (position.y + GetHeight() >= groundY - 5.0f);
+    return (position.y + GetHeight() >= groundY - movement.groundTolerance);
 }
 
 // 请求跳跃
@@ -282,12 +227,11 @@ void Dinosaur::RequestJump()
 // 执行跳跃
 void Dinosaur::ExecuteJump()
 {
-    velocity.y = jumpSpeed; // 设置向上的初始速度
+    velocity.y = movement.jumpSpeed; // 设置向上的初始速度
     isJumping = true;
     jumpQueued = false; // 消耗已缓存的跳跃请求
     jumpBufferCounter = 0.0f; // 重置跳跃缓冲计时器
-    currentAnimFrameIndex = 0;
-    PlaySound(jumpSoundHandle);
+    AudioSystem::Play(jumpSoundHandle);
 }
 
 // 开始潜行
@@ -303,8 +247,6 @@ void Dinosaur::StartSneaking()
         {
             position.y += (heightBeforeSneak - heightAfterSneak);
         }
-        currentAnimFrameIndex = 0;
-        frameTimeCounter = 0.0f;
     }
 }
 
@@ -325,53 +267,29 @@ void Dinosaur::StopSneaking()
                 position.y = groundY - heightAfterStand;
             }
         }
-        currentAnimFrameIndex = 0;
-        frameTimeCounter = 0.0f;
     }
 }
 
-// 获取当前动画应该使用的帧序列的指针
-const std::vector<Texture2D>* Dinosaur::GetCurrentAnimationFramesPointer() const
+// 获取当前状态对应的动画片段
+const AnimationClip& Dinosaur::GetCurrentClip() const
 {
-    if (isSneaking)
-    {
-        return &sneakFrames;
-    }
-    return &runFrames;
+    return AnimationLibrary::Get(isSneaking ? sneakClip : runClip);
 }
 
-// 获取当前应该绘制的单个纹理
-Texture2D Dinosaur::GetCurrentTextureToDraw() const
+// 获取当前应该绘制的纹理句柄：帧只取决于全局动画时钟，恐龙不保存播放进度
+TextureHandle Dinosaur::GetCurrentTextureHandle(const float animationTime) const
 {
     if (isDead)
     {
         return deadTexture;
     }
-
-    // 获取当前状态对应的动画帧组
-    if (const std::vector<Texture2D>* frames_ptr = GetCurrentAnimationFramesPointer(); frames_ptr && !frames_ptr->
-        empty())
+    const AnimationClip& clip = GetCurrentClip();
+    // 跳跃或冲刺时固定显示第一帧
+    if (isJumping || isDashing)
     {
-        const std::vector<Texture2D>& frames = *frames_ptr;
-        const int frameIdxToUse = currentAnimFrameIndex;
-
-        // 特殊处理跳跃或冲刺时的帧 (通常是固定的第一帧)
-        if ((isJumping || isDashing) && !isSneaking) // 跳跃/冲刺 且 不潜行
-        {
-            return runFrames[0];
-        }
-        if ((isJumping || isDashing) && isSneaking) // 跳跃/冲刺 且 潜行
-        {
-            return sneakFrames[0];
-        }
-
-        // 正常播放动画帧
-        if (frameIdxToUse >= 0 && frameIdxToUse < frames.size() && frames[frameIdxToUse].id > 0)
-        {
-            return frames[frameIdxToUse];
-        }
+        return clip.Sample(0.0f);
     }
-    return Texture2D{};
+    return clip.Sample(animationTime);
 }
 
 // 获取恐龙当前的高度
@@ -379,7 +297,7 @@ float Dinosaur::GetHeight() const
 {
     if (isDead)
     {
-        return static_cast<float>(deadTexture.height);
+        return static_cast<float>(TextureLibrary::Get(deadTexture).height);
     }
     if (isSneaking && sneakHeight > 0)
     {
@@ -393,10 +311,14 @@ float Dinosaur::GetWidth() const
 {
     if (isDead)
     {
-        return static_cast<float>(deadTexture.width);
+        return static_cast<float>(TextureLibrary::Get(deadTexture).width);
     }
-    if (const Texture2D tex = GetCurrentTextureToDraw(); tex.id > 0) return static_cast<float>(std::abs(tex.width));
-    return static_cast<float>(runFrames[0].width);
+    // 同一片段的各帧宽度相同，取第一帧即可，不依赖动画时钟
+    if (const Texture2D& tex = TextureLibrary::Get(GetCurrentClip().Sample(0.0f)); tex.id > 0)
+    {
+        return static_cast<float>(std::abs(tex.width));
+    }
+    return static_cast<float>(TextureLibrary::Get(AnimationLibrary::Get(runClip).Sample(0.0f)).width);
 }
 
 // 更新碰撞矩形的位置和大小
@@ -410,34 +332,40 @@ void Dinosaur::UpdateCollisionRect()
 
 // 获取用于碰撞检测的、调整过的矩形
 Rectangle Dinosaur::GetCollisionRect() const
+{
+    return ShrinkCollisionRect(collisionRect, isSneaking, isDashing);
+}
+
+// 把身体矩形缩减为实际用于碰撞检测的矩形
+Rectangle Dinosaur::ShrinkCollisionRect(const Rectangle bodyRect, const bool sneaking, const bool dashing)
 {
     float widthReductionFactor = 0.40f; // 水平方向缩减40%
     float heightReductionFactorTop = 0.25f; // 顶部缩减25%
     float heightReductionFactorBottom = 0.15f; // 底部缩减15%
 
-    if (isSneaking)
+    if (sneaking)
     {
         widthReductionFactor = 0.45f;
         heightReductionFactorTop = 0.30f;
         heightReductionFactorBottom = 0.10f;
     }
-    else if (isDashing)
+    else if (dashing)
     {
         widthReductionFactor = 0.50f;
         heightReductionFactorTop = 0.35f;
         heightReductionFactorBottom = 0.10f;
     }
 
-    const float horizontalPadding = collisionRect.width * widthReductionFactor;
-    const float verticalPaddingTop = collisionRect.height * heightReductionFactorTop;
-    const float verticalPaddingBottom = collisionRect.height * heightReductionFactorBottom;
+    const float horizontalPadding = bodyRect.width * widthReductionFactor;
+    const float verticalPaddingTop = bodyRect.height * heightReductionFactorTop;
+    const float verticalPaddingBottom = bodyRect.height * heightReductionFactorBottom;
 
     // 创建调整后的碰撞矩形
     Rectangle adjustedRect = {
-        collisionRect.x + horizontalPadding / 2.0f, // X向内缩进
-        collisionRect.y + verticalPaddingTop, // Y从顶部向下缩进
-        collisionRect.width - horizontalPadding, // 宽度减小
-        collisionRect.height - (verticalPaddingTop + verticalPaddingBottom) // 高度减小
+        bodyRect.x + horizontalPadding / 2.0f, // X向内缩进
+        bodyRect.y + verticalPaddingTop, // Y从顶部向下缩进
+        bodyRect.width - horizontalPadding, // 宽度减小
+        bodyRect.height - (verticalPaddingTop + verticalPaddingBottom) // 高度减小
     };
 
     if (adjustedRect.width < 1.0f) adjustedRect.width = 1.0f;
@@ -445,3 +373,43 @@ Rectangle Dinosaur::GetCollisionRect() const
 
     return adjustedRect;
 }
+
+// 将恐龙的物理和计时器状态写入快照
+void Dinosaur::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(position);
+    writer.Write(velocity);
+    writer.Write(groundY);
+    writer.Write(isJumping);
+    writer.Write(isSneaking);
+    writer.Write(facingRight);
+    writer.Write(isDead);
+    writer.Write(collisionRect);
+    writer.Write(jumpBufferCounter);
+    writer.Write(jumpQueued);
+    writer.Write(isDashing);
+    writer.Write(dashTimer);
+    writer.Write(dashCooldownTimer);
+    writer.Write(dashDirection);
+    writer.Write(dashParticleProps);
+}
+
+// 从快照恢复恐龙状态
+void Dinosaur::LoadState(SnapshotReader& reader)
+{
+    reader.Read(position);
+    reader.Read(velocity);
+    reader.Read(groundY);
+    reader.Read(isJumping);
+    reader.Read(isSneaking);
+    reader.Read(facingRight);
+    reader.Read(isDead);
+    reader.Read(collisionRect);
+    reader.Read(jumpBufferCounter);
+    reader.Read(jumpQueued);
+    reader.Read(isDashing);
+    reader.Read(dashTimer);
+    reader.Read(dashCooldownTimer);
+    reader.Read(dashDirection);
+    reader.Read(dashParticleProps);
+}
@@ -0,0 +1,126 @@
+// src/DynamicResolution.cpp
+#include "../include/DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution()
+    : targets{}, virtualWidth(0), level(0), enabled(true), smoothedFrameTime(0.0f), overloadCount(0),
+      headroomTime(0.0f), currentProbeInterval(0.0f), timeSinceProbe(0.0f), probing(false)
+{
+}
+
+// 为每个缩放级别创建渲染纹理，尺寸取整，保证每级都是整数像素
+void DynamicResolution::Initialize(const int width, const int height, const DynamicResolutionSettings& newSettings)
+{
+    Unload();
+    settings = newSettings;
+    virtualWidth = width;
+    for (size_t i = 0; i < SCALE_LEVELS.size(); ++i)
+    {
+        const int levelWidth = std::max(1, static_cast<int>(std::lround(width * SCALE_LEVELS[i])));
+        const int levelHeight = std::max(1, static_cast<int>(std::lround(height * SCALE_LEVELS[i])));
+        targets[i] = LoadRenderTexture(levelWidth, levelHeight);
+        SetTextureFilter(targets[i].texture, TEXTURE_FILTER_POINT); // 像素风，放大时不模糊
+    }
+    smoothedFrameTime = settings.frameBudget;
+    currentProbeInterval = settings.probeInterval;
+    SetLevel(0);
+}
+
+// 释放渲染纹理
+void DynamicResolution::Unload()
+{
+    for (auto& target : targets)
+    {
+        if (target.id > 0) UnloadRenderTexture(target);
+        target = {};
+    }
+}
+
+// 启用或关闭动态分辨率
+void DynamicResolution::SetEnabled(const bool enable)
+{
+    enabled = enable;
+    if (!enabled) SetLevel(0);
+}
+
+// 设置每帧预算
+void DynamicResolution::SetFrameBudget(const float seconds)
+{
+    settings.frameBudget = seconds;
+    smoothedFrameTime = seconds;
+    overloadCount = 0;
+    headroomTime = 0.0f;
+}
+
+// 切换到指定级别并重置计数
+void DynamicResolution::SetLevel(const int newLevel)
+{
+    level = std::clamp(newLevel, 0, static_cast<int>(SCALE_LEVELS.size()) - 1);
+    overloadCount = 0;
+    headroomTime = 0.0f;
+    timeSinceProbe = 0.0f;
+}
+
+// 报告上一帧的时间：连续超载时降一级；有余量一段时间后试着升一级，
+// 升级后很快又超载就退回并把下次等待时间翻倍，避免在两级之间来回跳
+bool DynamicResolution::ReportFrameTime(const float seconds)
+{
+    if (!enabled || seconds <= 0.0f) return false;
+    smoothedFrameTime += (seconds - smoothedFrameTime) * settings.smoothing;
+    timeSinceProbe += seconds;
+    const int previousLevel = level;
+
+    if (smoothedFrameTime > settings.frameBudget * settings.overloadRatio)
+    {
+        headroomTime = 0.0f;
+        if (++overloadCount >= settings.overloadFrames && level + 1 < static_cast<int>(SCALE_LEVELS.size()))
+        {
+            if (probing && timeSinceProbe < currentProbeInterval)
+            {
+                currentProbeInterval = std::min(currentProbeInterval * 2.0f, settings.maxProbeInterval);
+            }
+            probing = false;
+            SetLevel(level + 1);
+            smoothedFrameTime = settings.frameBudget; // 新级别重新开始统计
+        }
+    }
+    else
+    {
+        overloadCount = 0;
+        if (probing && timeSinceProbe >= currentProbeInterval)
+        {
+            probing = false; // 升级后稳定了一段时间，恢复默认等待间隔
+            currentProbeInterval = settings.probeInterval;
+        }
+        if (level > 0 && smoothedFrameTime <= settings.frameBudget * settings.headroomRatio)
+        {
+            headroomTime += seconds;
+            if (headroomTime >= currentProbeInterval)
+            {
+                SetLevel(level - 1);
+                probing = true;
+            }
+        }
+        else
+        {
+            headroomTime = 0.0f;
+        }
+    }
+    return level != previousLevel;
+}
+
+// 当前级别渲染纹理的源矩形
+Rectangle DynamicResolution::GetSourceRect() const
+{
+    const Texture2D& texture = targets[level].texture;
+    return {0.0f, 0.0f, static_cast<float>(texture.width), -static_cast<float>(texture.height)};
+}
+
+// 把虚拟坐标映射到当前渲染纹理的摄像机
+Camera2D DynamicResolution::GetCamera() const
+{
+    Camera2D camera{};
+    camera.zoom = virtualWidth > 0 ? static_cast<float>(targets[level].texture.width) / virtualWidth : 1.0f;
+    return camera;
+}
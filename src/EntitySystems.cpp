@@ -0,0 +1,81 @@
+// src/EntitySystems.cpp
+#include "../include/EntitySystems.h"
+
+// 移动：按固定的速度倍数跟随世界滚动
+void EntitySystems::Move(EntityWorld& world, const float deltaTime, const float worldScrollSpeed)
+{
+    world.ForEach(Component::POSITION | Component::MOVEMENT, [=](Archetype& archetype)
+    {
+        const size_t count = archetype.size();
+        Vector2* positions = archetype.positions.data();
+        const float* factors = archetype.speedFactors.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            positions[i].x -= worldScrollSpeed * factors[i] * deltaTime;
+        }
+    });
+}
+
+// 飞行：位置只取决于出生参数和当前时间，跳过的步或回放到任意时刻都得到同样的结果
+void EntitySystems::Fly(EntityWorld& world, const float time, const float scrollAcceleration)
+{
+    world.ForEach(Component::POSITION | Component::FLIGHT, [=](Archetype& archetype)
+    {
+        const size_t count = archetype.size();
+        Vector2* positions = archetype.positions.data();
+        const FlightState* flights = archetype.flights.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            positions[i] = flights[i].PositionAt(time, scrollAcceleration);
+        }
+    });
+}
+
+// 碰撞矩形：跟随位置和当前帧纹理尺寸 (鸟的两帧高度不同)
+void EntitySystems::UpdateColliders(EntityWorld& world, const float animationTime)
+{
+    world.ForEach(Component::POSITION | Component::SPRITE | Component::COLLIDER, [=](Archetype& archetype)
+    {
+        const size_t count = archetype.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Texture2D& texture = TextureLibrary::Get(archetype.FrameAt(i, animationTime));
+            archetype.colliders[i] = {
+                archetype.positions[i].x, archetype.positions[i].y,
+                static_cast<float>(texture.width), static_cast<float>(texture.height)
+            };
+        }
+    });
+}
+
+// 剔除：从后往前遍历，删除时移过来的最后一行已经检查过
+void EntitySystems::CullOffscreen(EntityWorld& world)
+{
+    std::vector<Archetype>& archetypes = world.GetArchetypes();
+    for (size_t a = 0; a < archetypes.size(); ++a)
+    {
+        Archetype& archetype = archetypes[a];
+        if (!archetype.Has(Component::COLLIDER)) continue;
+        for (size_t i = archetype.size(); i-- > 0;)
+        {
+            const Rectangle& collider = archetype.colliders[i];
+            if (collider.x + collider.width < 0.0f) world.Destroy(static_cast<ArchetypeId>(a), i);
+        }
+    }
+}
+
+// 绘制：位置取整，保证像素对齐
+void EntitySystems::Draw(const EntityWorld& world, const float animationTime, const RenderLayer layer,
+                         RenderCommandList& commands)
+{
+    world.ForEach(Component::POSITION | Component::SPRITE, [&](const Archetype& archetype)
+    {
+        const size_t count = archetype.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Vector2 position = archetype.positions[i];
+            commands.AddTexture(layer, archetype.FrameAt(i, animationTime),
+                                {static_cast<float>(static_cast<int>(position.x)), static_cast<float>(static_cast<int>(position.y))});
+        }
+    });
+}
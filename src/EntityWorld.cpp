@@ -0,0 +1,174 @@
+// src/EntityWorld.cpp
+#include "../include/EntityWorld.h"
+
+namespace
+{
+    // 删除一列中的一行：最后一行移到这里
+    template <typename T>
+    void SwapRemove(std::vector<T>& column, const size_t row)
+    {
+        if (column.empty()) return;
+        column[row] = column.back();
+        column.pop_back();
+    }
+
+    // 对原型的每一列调用 fn(column)
+    template <typename Fn>
+    void ForEachColumn(Archetype& archetype, Fn&& fn)
+    {
+        fn(archetype.positions);
+        fn(archetype.speedFactors);
+        fn(archetype.flights);
+        fn(archetype.frames);
+        fn(archetype.clips);
+        fn(archetype.animationPhases);
+        fn(archetype.colliders);
+    }
+
+    template <typename Fn>
+    void ForEachColumn(const Archetype& archetype, Fn&& fn)
+    {
+        fn(archetype.positions);
+        fn(archetype.speedFactors);
+        fn(archetype.flights);
+        fn(archetype.frames);
+        fn(archetype.clips);
+        fn(archetype.animationPhases);
+        fn(archetype.colliders);
+    }
+
+    // 原型拥有的列与行数一致，没有的列为空
+    bool IsConsistent(const Archetype& archetype)
+    {
+        const size_t count = archetype.size();
+        const auto sized = [count](const auto& column, const bool present)
+        {
+            return column.size() == (present ? count : 0);
+        };
+        const bool moves = archetype.Has(Component::MOVEMENT);
+        const bool animated = archetype.Has(Component::ANIMATION);
+        return sized(archetype.speedFactors, moves) && sized(archetype.flights, archetype.Has(Component::FLIGHT)) &&
+            sized(archetype.frames, archetype.Has(Component::SPRITE)) &&
+            sized(archetype.clips, animated) && sized(archetype.animationPhases, animated) &&
+            sized(archetype.colliders, archetype.Has(Component::COLLIDER));
+    }
+}
+
+// 有动画的实体按时钟加相位从片段取样，静态的实体画第一帧
+TextureHandle Archetype::FrameAt(const size_t row, const float animationTime) const
+{
+    if (Has(Component::ANIMATION))
+    {
+        return AnimationLibrary::Sample(clips[row], animationTime + animationPhases[row]);
+    }
+    return frames[row].empty() ? INVALID_TEXTURE : frames[row][0];
+}
+
+// 注册一个原型，所有实体都有位置，所以总是带上 POSITION
+ArchetypeId EntityWorld::RegisterArchetype(ComponentMask mask)
+{
+    mask |= Component::POSITION;
+    for (size_t i = 0; i < archetypes.size(); ++i)
+    {
+        if (archetypes[i].mask == mask) return static_cast<ArchetypeId>(i);
+    }
+    Archetype archetype;
+    archetype.mask = mask;
+    archetypes.push_back(archetype);
+    return static_cast<ArchetypeId>(archetypes.size()) - 1;
+}
+
+// 在原型中创建实体，只向原型拥有的列追加数据
+size_t EntityWorld::Create(const ArchetypeId archetype, const EntityDesc& desc)
+{
+    Archetype& target = archetypes[archetype];
+    target.positions.push_back(desc.position);
+    if (target.Has(Component::MOVEMENT))
+    {
+        target.speedFactors.push_back(desc.speedFactor);
+    }
+    if (target.Has(Component::FLIGHT))
+    {
+        target.flights.push_back(desc.flight);
+    }
+    if (target.Has(Component::SPRITE))
+    {
+        target.frames.push_back(desc.frames);
+    }
+    if (target.Has(Component::ANIMATION))
+    {
+        target.clips.push_back(desc.clip);
+        target.animationPhases.push_back(desc.animationPhase);
+    }
+    if (target.Has(Component::COLLIDER))
+    {
+        Rectangle collider = {desc.position.x, desc.position.y, 0.0f, 0.0f};
+        if (target.Has(Component::SPRITE) && !desc.frames.empty())
+        {
+            const Texture2D& texture = TextureLibrary::Get(desc.frames[0]);
+            collider.width = static_cast<float>(texture.width);
+            collider.height = static_cast<float>(texture.height);
+        }
+        target.colliders.push_back(collider);
+    }
+    return target.size() - 1;
+}
+
+// 删除原型中的一行
+void EntityWorld::Destroy(const ArchetypeId archetype, const size_t row)
+{
+    ForEachColumn(archetypes[archetype], [row](auto& column) { SwapRemove(column, row); });
+}
+
+// 删除所有实体，保留原型
+void EntityWorld::Clear()
+{
+    for (auto& archetype : archetypes)
+    {
+        ForEachColumn(archetype, [](auto& column) { column.clear(); });
+    }
+}
+
+// 删除所有原型
+void EntityWorld::Reset()
+{
+    archetypes.clear();
+}
+
+// 实体总数
+size_t EntityWorld::GetEntityCount() const
+{
+    size_t count = 0;
+    for (const auto& archetype : archetypes) count += archetype.size();
+    return count;
+}
+
+// 写入快照：原型数和各原型的组件组合，然后逐列整块写入
+void EntityWorld::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(archetypes.size());
+    for (const auto& archetype : archetypes)
+    {
+        writer.Write(archetype.mask);
+        ForEachColumn(archetype, [&writer](const auto& column) { writer.WriteVector(column); });
+    }
+}
+
+// 从快照恢复
+bool EntityWorld::LoadState(SnapshotReader& reader)
+{
+    size_t count = 0;
+    bool valid = reader.Read(count) && count == archetypes.size();
+    for (size_t i = 0; valid && i < count; ++i)
+    {
+        ComponentMask mask = 0;
+        valid = reader.Read(mask) && mask == archetypes[i].mask;
+        ForEachColumn(archetypes[i], [&reader, &valid](auto& column)
+        {
+            valid = valid && reader.ReadVector(column);
+        });
+        valid = valid && IsConsistent(archetypes[i]);
+    }
+    if (!valid) Clear();
+    return valid;
+}
@@ -0,0 +1,36 @@
+// src/FlightPath.cpp
+#include "../include/FlightPath.h"
+#include <algorithm>
+#include <cmath>
+
+// 飞过 flown 水平距离时的高度系数
+float FlightPath::HeightFactorAt(const float baseHeight, const float flown) const
+{
+    float offset = 0.0f;
+    switch (profile)
+    {
+    case FlightProfile::SWOOP:
+        offset = amplitude * std::sin(2.0f * PI * (flown - start) / length);
+        break;
+    case FlightProfile::DIVE:
+        {
+            // 平滑插值：开始和结束时竖直速度为0，俯冲过程没有突变
+            const float t = std::clamp((flown - start) / length, 0.0f, 1.0f);
+            offset = amplitude * t * t * (3.0f - 2.0f * t);
+            break;
+        }
+    default:
+        break;
+    }
+    return std::clamp(baseHeight + offset, 0.0f, 1.0f);
+}
+
+// 游戏时间为 time 时的左上角位置
+Vector2 FlightState::PositionAt(const float time, const float scrollAcceleration) const
+{
+    const float flightTime = std::max(time - spawnTime, 0.0f);
+    const float scrolled = spawnScrollSpeed * flightTime + 0.5f * scrollAcceleration * flightTime * flightTime;
+    const float flown = path.FlownDistance(scrolled);
+    const float height = path.HeightFactorAt(baseHeight, flown);
+    return {spawnX - flown, highestTop + (lowestTop - highestTop) * height};
+}
@@ -0,0 +1,89 @@
+// src/FrameGraph.cpp
+#include "../include/FrameGraph.h"
+#include <thread>
+
+// 添加任务并登记为前置任务的后继
+FrameGraph::NodeId FrameGraph::Add(const char* name, std::function<void()> work,
+                                   const std::initializer_list<NodeId> dependencies, const JobAffinity affinity)
+{
+    const auto id = static_cast<NodeId>(nodes.size());
+    nodes.push_back({name, std::move(work), {}, static_cast<int>(dependencies.size()), affinity});
+    for (const NodeId dependency : dependencies)
+    {
+        nodes[dependency].dependents.push_back(id);
+    }
+    remaining = std::make_unique<std::atomic<int>[]>(nodes.size());
+    runTimings.resize(nodes.size());
+    timings.resize(nodes.size());
+    return id;
+}
+
+// 执行一次整张图
+// CALLER 任务严格按添加顺序执行，使用线程局部随机数的任务因此每次以相同顺序取数，模拟保持确定
+void FrameGraph::Run(JobSystem& jobs)
+{
+    if (nodes.empty()) return;
+    scheduler = &jobs;
+    runStart = Clock::now();
+    unfinished.store(static_cast<int>(nodes.size()), std::memory_order_relaxed);
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        remaining[i].store(nodes[i].dependencyCount, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].dependencyCount == 0 && nodes[i].affinity == JobAffinity::ANY)
+        {
+            jobs.Submit({&FrameGraph::ExecuteJob, this, static_cast<int>(i)});
+        }
+    }
+
+    size_t nextCallerNode = 0;
+    while (unfinished.load(std::memory_order_acquire) > 0)
+    {
+        while (nextCallerNode < nodes.size() && nodes[nextCallerNode].affinity != JobAffinity::CALLER)
+        {
+            ++nextCallerNode;
+        }
+        if (nextCallerNode < nodes.size() && remaining[nextCallerNode].load(std::memory_order_acquire) == 0)
+        {
+            Execute(static_cast<NodeId>(nextCallerNode++));
+        }
+        else if (!jobs.TryRunOne())
+        {
+            std::this_thread::yield(); // 剩下的任务都在工作线程上，任务很短，不值得睡眠
+        }
+    }
+    lastDuration = std::chrono::duration<float, std::milli>(Clock::now() - runStart).count();
+    timings = runTimings;
+}
+
+// 执行一个任务，记录耗时，然后把依赖已全部完成的后继任务交给调度器
+void FrameGraph::Execute(const NodeId node)
+{
+    const auto start = Clock::now();
+    nodes[node].work();
+    const auto end = Clock::now();
+    runTimings[node] = {
+        nodes[node].name,
+        std::chrono::duration<float, std::milli>(start - runStart).count(),
+        std::chrono::duration<float, std::milli>(end - start).count(),
+        JobSystem::CurrentWorker()
+    };
+
+    for (const NodeId dependent : nodes[node].dependents)
+    {
+        if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+            nodes[dependent].affinity == JobAffinity::ANY)
+        {
+            scheduler->Submit({&FrameGraph::ExecuteJob, this, dependent});
+        }
+    }
+    unfinished.fetch_sub(1, std::memory_order_release);
+}
+
+// 调度器回调
+void FrameGraph::ExecuteJob(void* context, const int index)
+{
+    static_cast<FrameGraph*>(context)->Execute(index);
+}
@@ -0,0 +1,128 @@
+// src/FramePacer.cpp
+#include "../include/FramePacer.h"
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    constexpr float MIN_SPIN_MARGIN = 0.0005f; // 自旋余量下限 (秒)
+    constexpr float MAX_SPIN_MARGIN = 0.004f; // 自旋余量上限 (秒)，系统定时器很粗时也不至于空转太久
+}
+
+FramePacer::FramePacer()
+    : mode(FramePacingMode::CAPPED), targetFps(DEFAULT_TARGET_FPS), framePeriod(0), frameStart(Clock::now()),
+      nextFrameStart(frameStart), sleepOvershoot(0.001f), lastWorkTime(0.0f), intervals{}, intervalCount(0),
+      intervalIndex(0)
+{
+}
+
+// 切换模式
+void FramePacer::SetMode(const FramePacingMode newMode, const int fps)
+{
+    mode = newMode;
+    targetFps = std::max(fps, 1);
+    framePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+    SetTargetFPS(0); // 等待由本类负责，raylib 的 EndDrawing 不再等待
+    if (mode == FramePacingMode::VSYNC) SetWindowState(FLAG_VSYNC_HINT);
+    else ClearWindowState(FLAG_VSYNC_HINT);
+
+    frameStart = Clock::now();
+    nextFrameStart = frameStart + framePeriod;
+    intervalCount = 0;
+    intervalIndex = 0;
+}
+
+// 先睡眠到截止时间前的余量，再自旋到截止时间
+// 睡眠的实际时长取决于系统定时器精度，余量按测得的睡眠超时自适应
+void FramePacer::WaitUntil(const Clock::time_point deadline)
+{
+    const float spinMargin = std::clamp(sleepOvershoot * 1.5f, MIN_SPIN_MARGIN, MAX_SPIN_MARGIN);
+    const auto sleepUntil = deadline - std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(spinMargin));
+    if (const auto beforeSleep = Clock::now(); beforeSleep < sleepUntil)
+    {
+        std::this_thread::sleep_until(sleepUntil);
+        const float overshoot = std::chrono::duration<float>(Clock::now() - sleepUntil).count();
+        sleepOvershoot += (std::max(overshoot, 0.0f) - sleepOvershoot) * 0.1f;
+    }
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+// 一帧结束：CAPPED 模式下等到下一帧的开始时间，并记录帧间隔
+void FramePacer::EndFrame()
+{
+    const auto workEnd = Clock::now();
+    lastWorkTime = std::chrono::duration<float>(workEnd - frameStart).count();
+    if (mode == FramePacingMode::CAPPED)
+    {
+        // 落后超过一帧时不追赶，从现在重新排期，避免连续几帧不等待
+        if (workEnd > nextFrameStart + framePeriod) nextFrameStart = workEnd;
+        WaitUntil(nextFrameStart);
+        nextFrameStart += framePeriod;
+    }
+
+    const auto now = Clock::now();
+    intervals[intervalIndex] = std::chrono::duration<float>(now - frameStart).count();
+    intervalIndex = (intervalIndex + 1) % HISTORY_SIZE;
+    intervalCount = std::min(intervalCount + 1, HISTORY_SIZE);
+    frameStart = now;
+}
+
+// 空闲等待之后重新开始计时
+void FramePacer::SkipIdleTime()
+{
+    frameStart = Clock::now();
+    nextFrameStart = frameStart + framePeriod;
+}
+
+// 每帧预算
+float FramePacer::GetFrameBudget() const
+{
+    if (mode == FramePacingMode::VSYNC)
+    {
+        const int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+        if (refreshRate > 0) return 1.0f / static_cast<float>(refreshRate);
+    }
+    return 1.0f / static_cast<float>(targetFps);
+}
+
+// 最近一段时间的帧节奏统计
+FramePacingStats FramePacer::GetStats() const
+{
+    FramePacingStats stats;
+    stats.workTime = lastWorkTime;
+    if (intervalCount == 0) return stats;
+
+    float sum = 0.0f;
+    for (int i = 0; i < intervalCount; ++i) sum += intervals[i];
+    stats.averageFrameTime = sum / static_cast<float>(intervalCount);
+    float squaredSum = 0.0f;
+    for (int i = 0; i < intervalCount; ++i)
+    {
+        const float deviation = intervals[i] - stats.averageFrameTime;
+        squaredSum += deviation * deviation;
+        stats.worstDeviation = std::max(stats.worstDeviation, std::abs(deviation));
+    }
+    stats.jitter = std::sqrt(squaredSum / static_cast<float>(intervalCount));
+    return stats;
+}
+
+// 模式名称
+const char* FramePacer::GetModeName(const FramePacingMode pacingMode)
+{
+    switch (pacingMode)
+    {
+    case FramePacingMode::UNCAPPED:
+        return "uncapped";
+    case FramePacingMode::VSYNC:
+        return "vsync";
+    case FramePacingMode::CAPPED:
+        return "capped";
+    }
+    return "";
+}
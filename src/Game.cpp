@@ -2,38 +2,43 @@
 #include "../include/Game.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 
 Game::Game(const int width, const int height, const char* title)
     : screenWidth(width), screenHeight(height),
-      virtualScreenWidth(960.f), virtualScreenHeight(540.f), targetRenderTexture{},
-      sourceRec{0.0f, 0.0f, static_cast<float>(virtualScreenWidth), static_cast<float>(virtualScreenHeight)}, // 渲染源矩形
+      virtualScreenWidth(960.f), virtualScreenHeight(540.f),
       destRec{0.0f, 0.0f, static_cast<float>(screenWidth), static_cast<float>(screenHeight)},
-      origin{0.0f, 0.0f}, isFullscreen(false),
+      origin{0.0f, 0.0f}, showPerformance(false), performanceTextTimer(0.0f), redrawRequested(true),
+      idleSettleTimer(0.0f), isFullscreen(false),
       windowedPosX(0), windowedPosY(0),
       windowedWidth(width), windowedHeight(height),
-      dino(nullptr), playerSword(nullptr),
+      simulationRunning(false), simulationPauseRequested(false), simulationPaused(false), quitRequested(false),
+      simulationStepTime(0.0f), renderFrame(nullptr),
+      cactusArchetype(INVALID_ARCHETYPE), birdArchetype(INVALID_ARCHETYPE),
       currentState(GameState::PLAYING),
       groundY(0),
       timePlayed(0.0f),
+      animationTime(0.0f),
       score(0),
       worldBaseScrollSpeed(400.0f),
       currentWorldScrollSpeed(worldBaseScrollSpeed),
       worldSpeedIncreaseRate(10.0f),
-      obstacleSpawnTimer(0.0f),
-      minObstacleSpawnInterval(0.3f), maxObstacleSpawnInterval(1.8f),
-      currentObstacleSpawnInterval(0.0f),
-      dinoDeadTexture{},
-      cloudTexture{}, swordTexture{},
-      jumpSound{nullptr}, dashSound{nullptr}, deadSound{nullptr},
-      bombSound{nullptr}, swordSound{nullptr}, screamSound{nullptr},
-      bgmMusic{nullptr},
+      nextSpawnEventIndex(0),
+      spawnDistanceRemaining(0.0f),
+      dinoRunClip(INVALID_CLIP), dinoSneakClip(INVALID_CLIP), birdFlapClip(INVALID_CLIP),
+      dinoDeadTexture(INVALID_TEXTURE),
+      cloudTexture(INVALID_TEXTURE), swordTexture(INVALID_TEXTURE),
+      jumpSound(INVALID_SOUND), dashSound(INVALID_SOUND), deadSound(INVALID_SOUND),
+      bombSound(INVALID_SOUND), swordSound(INVALID_SOUND), screamSound(INVALID_SOUND),
+      musicStarted(false),
+      dashTrailParticles(150),
       birdDeathParticles(300)
 {
     SetConfigFlags(FLAG_WINDOW_RESIZABLE); // 设置窗口可调整大小标志
     InitWindow(screenWidth, screenHeight, title);
     SetExitKey(KEY_NULL);
     InitAudioDevice();
-    nextCloudSpawnTime = randF(1, 6);
 
     // 用于从全屏恢复
     const auto [x, y] = GetWindowPosition();
@@ -41,9 +46,10 @@ Game::Game(const int width, const int height, const char* title)
     windowedPosY = static_cast<int>(y);
 
     SetWindowMinSize(virtualScreenWidth / 2, virtualScreenHeight / 2); // 窗口最小尺寸
-    SetTargetFPS(160);
-    targetRenderTexture = LoadRenderTexture(virtualScreenWidth, virtualScreenHeight);
-    SetTextureFilter(targetRenderTexture.texture, TEXTURE_FILTER_POINT); // 设置渲染纹理的过滤模式为点状 像素风
+    framePacer.SetMode(FramePacingMode::CAPPED, FramePacer::DEFAULT_TARGET_FPS);
+    DynamicResolutionSettings resolutionSettings;
+    resolutionSettings.frameBudget = framePacer.GetFrameBudget();
+    dynamicResolution.Initialize(virtualScreenWidth, virtualScreenHeight, resolutionSettings);
 
     groundY = static_cast<float>(virtualScreenHeight) * 0.85f;
     LoadResources();
@@ -66,142 +72,267 @@ Game::Game(const int width, const int height, const char* title)
     birdDeathParticles.SetGravity({0, 800.0f});
 
     instructionManager.Initialize(virtualScreenWidth, groundY, bombSound);
+    menuLayout = MenuLayout::Compute(virtualScreenWidth, virtualScreenHeight);
+    uiLayers.Initialize(menuLayout, virtualScreenWidth, virtualScreenHeight);
+    groundDecals.Load(virtualScreenWidth, groundY - 32.0f, 64); // 条带覆盖粒子落地的高度
+    ParticleSystem::SetJobSystem(&jobSystem); // 粒子很多时分块并行更新
+    ParticleSystem::SetGroundDecals(&groundDecals); // 落地粒子烘焙成路面印记
     InitGame();
+    BuildFrameGraphs();
+    PublishRenderSnapshot(); // 模拟线程启动前先发布第一帧
+    AudioSystem::Start();
+    assetWatcher.Start("assets");
     HandleWindowResize(); // 处理初始窗口大小，设置渲染缩放
 }
 
 Game::~Game()
 {
-    UnloadRenderTexture(targetRenderTexture);
+    StopSimulation();
+    ParticleSystem::SetJobSystem(nullptr);
+    ParticleSystem::SetGroundDecals(nullptr);
+    assetWatcher.Stop();
+    AudioSystem::Stop();
+    dynamicResolution.Unload();
+    uiLayers.Unload();
+    groundDecals.Unload();
     UnloadResources();
-    delete dino;
-    delete playerSword;
     CloseAudioDevice();
     CloseWindow();
 }
 
 void Game::LoadResources()
 {
-    dinoRunFrames.clear();
-    dinoSneakFrames.clear();
-    smallCactusTextures.clear();
-    bigCactusTextures.clear();
-    roadSegmentTextures.clear();
-    birdFrames.clear();
-    if (const Texture2D tempSwordTex = LoadTexture("assets/images/sword.png"); tempSwordTex.id > 0)
+    TextureLibrary::UnloadAll();
+    AnimationLibrary::Clear();
+    TextLayoutCache::Clear();
+    TextLayoutCache::RegisterFont(GetFontDefault());
+    swordTexture = TextureLibrary::Load("assets/images/sword.png");
+    dinoDeadTexture = TextureLibrary::Load("assets/images/dino_dead.png");
+    cloudTexture = TextureLibrary::Load("assets/images/cloud.png");
+    background.ClearLayers();
+    background.SetViewWidth(static_cast<float>(virtualScreenWidth));
+    ParallaxLayerConfig cloudLayer;
+    cloudLayer.texture = cloudTexture;
+    cloudLayer.scrollFactor = 0.05f;
+    cloudLayer.driftSpeedMin = 15.0f;
+    cloudLayer.driftSpeedMax = 45.0f;
+    cloudLayer.minY = virtualScreenHeight / 8.0f;
+    cloudLayer.maxY = virtualScreenHeight / 2.0f;
+    cloudLayer.spawnGapMin = 50.0f;
+    cloudLayer.spawnGapMax = static_cast<float>(TextureLibrary::Get(cloudTexture).width * 2);
+    cloudLayer.spawnIntervalMin = 1.0f;
+    cloudLayer.spawnIntervalMax = 6.0f;
+    cloudLayer.capacity = 32;
+    background.AddLayer(cloudLayer);
+    dinoRunFrames = TextureLibrary::LoadGroup({"assets/images/dino_run_1.png", "assets/images/dino_run_2.png"});
+    dinoSneakFrames = TextureLibrary::LoadGroup({"assets/images/dino_sneak_1.png", "assets/images/dino_sneak_2.png"});
+    smallCactusTextures = TextureLibrary::LoadGroup({
+        "assets/images/small_cactus_1.png", "assets/images/small_cactus_2.png",
+        "assets/images/small_cactus_3.png"
+    });
+    bigCactusTextures = TextureLibrary::LoadGroup({"assets/images/big_cactus_1.png", "assets/images/big_cactus_2.png"});
+    ground.Load({
+        "assets/images/road_1.png", "assets/images/road_2.png", "assets/images/road_3.png",
+        "assets/images/road_4.png"
+    }, static_cast<float>(virtualScreenWidth));
+    birdFrames = TextureLibrary::LoadGroup({"assets/images/bird_1.png", "assets/images/bird_2.png"});
+    // 动画片段在模拟线程启动前注册，之后只读；快照里保存的片段句柄按注册顺序对应
+    dinoRunClip = AnimationLibrary::Add({dinoRunFrames, 0.08f, AnimationLoop::LOOP});
+    dinoSneakClip = AnimationLibrary::Add({dinoSneakFrames, 0.08f, AnimationLoop::LOOP});
+    birdFlapClip = AnimationLibrary::Add({birdFrames, 0.15f, AnimationLoop::LOOP});
+    entities.Reset();
+    cactusArchetype = entities.RegisterArchetype(Component::MOVEMENT | Component::SPRITE | Component::COLLIDER |
+        Component::LETHAL);
+    birdArchetype = entities.RegisterArchetype(Component::FLIGHT | Component::SPRITE | Component::ANIMATION |
+        Component::COLLIDER | Component::LETHAL | Component::SLASHABLE);
+    AudioSystem::UnloadAll();
+    // 优先级：死亡 > 爆炸 > 玩家动作 > 鸟叫；鸟叫允许多个叠加，大量击杀时也不会挤掉玩家动作的音效
+    auto LoadSoundEffect = [](const char* path, SoundHandle& sound, const int priority, const int maxVoices)
     {
-        SetTextureFilter(tempSwordTex, TEXTURE_FILTER_POINT);
-        swordTexture = tempSwordTex;
-    }
-    if (const Texture2D tempTex = LoadTexture("assets/images/dino_dead.png"); tempTex.id > 0)
-    {
-        SetTextureFilter(tempTex, TEXTURE_FILTER_POINT);
-        dinoDeadTexture = tempTex;
-    }
-    if (const Texture2D tempTex = LoadTexture("assets/images/cloud.png"); tempTex.id > 0)
-    {
-        SetTextureFilter(tempTex, TEXTURE_FILTER_POINT);
-        cloudTexture = tempTex;
-    }
-    auto LoadTextures = [](const std::vector<std::string>& paths, std::vector<Texture2D>& container)
-    {
-        for (const auto& path : paths)
-        {
-            if (Texture2D tempTex = LoadTexture(path.c_str()); tempTex.id > 0)
-            {
-                SetTextureFilter(tempTex, TEXTURE_FILTER_POINT);
-                container.push_back(tempTex);
-            }
-        }
+        sound = AudioSystem::LoadSound(path, {priority, maxVoices, 1.0f});
     };
-    LoadTextures({"assets/images/dino_run_1.png", "assets/images/dino_run_2.png"}, dinoRunFrames);
-    LoadTextures({"assets/images/dino_sneak_1.png", "assets/images/dino_sneak_2.png"}, dinoSneakFrames);
-    LoadTextures({
-                     "assets/images/small_cactus_1.png", "assets/images/small_cactus_2.png",
-                     "assets/images/small_cactus_3.png"
-                 }, smallCactusTextures);
-    LoadTextures({"assets/images/big_cactus_1.png", "assets/images/big_cactus_2.png"}, bigCactusTextures);
-    LoadTextures({
-                     "assets/images/road_1.png", "assets/images/road_2.png", "assets/images/road_3.png",
-                     "assets/images/road_4.png"
-                 }, roadSegmentTextures);
-    LoadTextures({"assets/images/bird_1.png", "assets/images/bird_2.png"}, birdFrames);
-    auto LoadSoundEffect = [](const char* path, Sound& sound)
-    {
-        sound = LoadSound(path);
+    LoadSoundEffect("assets/sounds/jump.wav", jumpSound, 1, 1);
+    LoadSoundEffect("assets/sounds/dash.wav", dashSound, 1, 1);
+    LoadSoundEffect("assets/sounds/dead.wav", deadSound, 3, 1);
+    LoadSoundEffect("assets/sounds/bomb.wav", bombSound, 2, 2);
+    LoadSoundEffect("assets/sounds/scream.wav", screamSound, 0, 4);
+    LoadSoundEffect("assets/sounds/sword.wav", swordSound, 1, 2);
+    AudioSystem::LoadMusic("assets/sounds/bgm.qoa", 0.3f);
+
+    // 按纹理尺寸设置生成几何，并让后台生成器用通关验证器过滤无法通过的分块
+    spawnGeometry = SpawnGeometry{};
+    spawnGeometry.screenWidth = static_cast<float>(virtualScreenWidth);
+    spawnGeometry.screenHeight = static_cast<float>(virtualScreenHeight);
+    spawnGeometry.groundY = groundY;
+    spawnGeometry.dinoStartX = virtualScreenWidth / 4.0f;
+    auto TextureSize = [](const TextureHandle handle)
+    {
+        const Texture2D& texture = TextureLibrary::Get(handle);
+        return Vector2{static_cast<float>(texture.width), static_cast<float>(texture.height)};
     };
-    LoadSoundEffect("assets/sounds/jump.wav", jumpSound);
-    LoadSoundEffect("assets/sounds/dash.wav", dashSound);
-    LoadSoundEffect("assets/sounds/dead.wav", deadSound);
-    LoadSoundEffect("assets/sounds/bomb.wav", bombSound);
-    LoadSoundEffect("assets/sounds/scream.wav", screamSound);
-    LoadSoundEffect("assets/sounds/sword.wav", swordSound);
-    bgmMusic = LoadMusicStream("assets/sounds/bgm.wav");
-    SetMusicVolume(bgmMusic, 0.3f);
+    for (int i = 0; i < smallCactusTextures.size(); ++i)
+        spawnGeometry.smallCactusSizes.push_back(TextureSize(smallCactusTextures[i]));
+    for (int i = 0; i < bigCactusTextures.size(); ++i)
+        spawnGeometry.bigCactusSizes.push_back(TextureSize(bigCactusTextures[i]));
+    if (!birdFrames.empty()) spawnGeometry.birdSize = TextureSize(birdFrames[0]);
+    if (!dinoRunFrames.empty()) spawnGeometry.dinoRunSize = TextureSize(dinoRunFrames[0]);
+    if (!dinoSneakFrames.empty()) spawnGeometry.dinoSneakSize = TextureSize(dinoSneakFrames[0]);
+    spawnGenerator.SetVerifier(std::make_shared<PassabilityVerifier>(DinoMovementModel{}, spawnGeometry));
 }
 
 void Game::UnloadResources()
 {
-    for (const auto& tex : dinoRunFrames) if (tex.id > 0) UnloadTexture(tex);
-    dinoRunFrames.clear();
-    for (const auto& tex : dinoSneakFrames) if (tex.id > 0) UnloadTexture(tex);
-    dinoSneakFrames.clear();
-    for (const auto& tex : smallCactusTextures) if (tex.id > 0) UnloadTexture(tex);
-    smallCactusTextures.clear();
-    for (const auto& tex : bigCactusTextures) if (tex.id > 0) UnloadTexture(tex);
-    bigCactusTextures.clear();
-    for (const auto& tex : roadSegmentTextures) if (tex.id > 0) UnloadTexture(tex);
-    roadSegmentTextures.clear();
-    for (const auto& tex : birdFrames) if (tex.id > 0) UnloadTexture(tex);
-    birdFrames.clear();
-    if (dinoDeadTexture.id > 0) UnloadTexture(dinoDeadTexture);
-    if (cloudTexture.id > 0) UnloadTexture(cloudTexture);
-    if (swordTexture.id > 0) UnloadTexture(swordTexture);
-    if (swordSound.frameCount > 0) UnloadSound(swordSound);
-    if (jumpSound.frameCount > 0) UnloadSound(jumpSound);
-    if (dashSound.frameCount > 0) UnloadSound(dashSound);
-    if (deadSound.frameCount > 0) UnloadSound(deadSound);
-    if (bombSound.frameCount > 0) UnloadSound(bombSound);
-    if (screamSound.frameCount > 0) UnloadSound(screamSound);
-    if (bgmMusic.frameCount > 0)
-    {
-        StopMusicStream(bgmMusic);
-        UnloadMusicStream(bgmMusic);
-    }
+    TextureLibrary::UnloadAll();
+    AnimationLibrary::Clear();
+    TextLayoutCache::Clear();
+    AudioSystem::UnloadAll();
+}
+
+// 建立任务图：互不依赖的系统并行执行
+// 使用线程局部随机数的系统固定在调用线程上按添加顺序执行，随机数的消费顺序与串行时相同，模拟保持确定
+void Game::BuildFrameGraphs()
+{
+    // 教学文本会播放音效，爆炸粒子使用线程局部随机数；放在最前面，随机数的消费顺序与串行时相同
+    simulationGraph.Add("instructions", [this]
+    {
+        instructionManager.Update(simulationStepTime, currentWorldScrollSpeed, timePlayed);
+    }, {}, JobAffinity::CALLER);
+    simulationGraph.Add("player", [this]
+    {
+        dino->Update(simulationStepTime, currentWorldScrollSpeed, dashTrailParticles);
+        if (playerSword) playerSword->Update(simulationStepTime, *dino);
+
+        if (dino->position.x < 0) dino->position.x = 0; // 防止移出左边界
+        if (dino->position.x + dino->GetWidth() > virtualScreenWidth) // 防止移出右边界
+        {
+            dino->position.x = virtualScreenWidth - dino->GetWidth();
+        }
+    }, {}, JobAffinity::CALLER);
+    simulationGraph.Add("ground", [this]
+    {
+        ground.Scroll(currentWorldScrollSpeed * simulationStepTime);
+    }, {}, JobAffinity::CALLER);
+    simulationGraph.Add("background", [this]
+    {
+        background.Update(simulationStepTime, currentWorldScrollSpeed);
+    }, {}, JobAffinity::CALLER);
+    const auto move = simulationGraph.Add("entities.move", [this]
+    {
+        EntitySystems::Move(entities, simulationStepTime, currentWorldScrollSpeed);
+    });
+    const auto fly = simulationGraph.Add("entities.fly", [this]
+    {
+        EntitySystems::Fly(entities, timePlayed, worldSpeedIncreaseRate);
+    });
+    simulationGraph.Add("particles.birdDeath", [this]
+    {
+        birdDeathParticles.Update(simulationStepTime);
+    });
+    const auto colliders = simulationGraph.Add("entities.colliders", [this]
+    {
+        EntitySystems::UpdateColliders(entities, animationTime);
+    }, {move, fly});
+    simulationGraph.Add("entities.cull", [this]
+    {
+        EntitySystems::CullOffscreen(entities);
+    }, {colliders});
+
+    // 抬头显示排版和菜单纹理更新需要主线程 (GPU)，世界部分的命令与它们并行构建
+    const auto hud = renderGraph.Add("hud", [this]
+    {
+        UpdateHud(*renderFrame);
+        if (renderFrame->state == GameState::PAUSED)
+        {
+            uiLayers.UpdatePauseLayer(menuLayout.HitTest(GetVirtualMousePosition()));
+        }
+    }, {}, JobAffinity::CALLER);
+    renderGraph.Add("decals", [this]
+    {
+        groundDecals.Bake(renderFrame->groundDecals);
+    }, {}, JobAffinity::CALLER);
+    const auto world = renderGraph.Add("commands.world", [this]
+    {
+        RenderCommandBuilder::BuildWorld(*renderFrame, MakeRenderInputs(), renderCommands);
+    });
+    const auto overlay = renderGraph.Add("commands.overlay", [this]
+    {
+        RenderCommandBuilder::BuildOverlay(*renderFrame, MakeRenderInputs(), overlayCommands);
+    }, {hud});
+    renderGraph.Add("commands.sort", [this]
+    {
+        renderCommands.Append(overlayCommands);
+        renderCommands.Sort();
+    }, {world, overlay});
 }
 
 void Game::InitGame()
 {
     groundY = static_cast<float>(virtualScreenHeight) * 0.85f;
 
-    delete dino;
-    dino = new Dinosaur(virtualScreenWidth / 4.0f, groundY,
-                        dinoRunFrames, dinoSneakFrames,
-                        dinoDeadTexture,
-                        jumpSound, dashSound);
+    dino.emplace(virtualScreenWidth / 4.0f, groundY,
+                 dinoRunClip, dinoSneakClip,
+                 dinoDeadTexture,
+                 jumpSound, dashSound);
+    dashTrailParticles.Reset();
+    dashTrailParticles.SetGravity({0, dino->GetMovementModel().gravity});
 
-    delete playerSword;
-    playerSword = new Sword(swordTexture, swordSound, dino);
+    playerSword.emplace(swordTexture, swordSound);
 
-    obstacles.clear();
-    birds.clear();
-    activeClouds.clear();
-
-    cloudSpawnTimerValue = 0.0f;
-    nextCloudSpawnTime = randF(1.0f, 6.0f);
+    entities.Clear();
+    background.Reset();
     score = 0;
     timePlayed = 0.0f;
+    animationTime = 0.0f;
     worldBaseScrollSpeed = 200.0f;
     currentWorldScrollSpeed = worldBaseScrollSpeed;
-    obstacleSpawnTimer = 0.0f;
-    currentObstacleSpawnInterval = randF(minObstacleSpawnInterval, maxObstacleSpawnInterval);
-    InitRoads();
+    currentSpawnChunk = SpawnChunk{};
+    nextSpawnEventIndex = 0;
+    spawnDistanceRemaining = 0.0f;
+    SpawnGeneratorConfig spawnConfig;
+    spawnConfig.baseScrollSpeed = worldBaseScrollSpeed;
+    spawnConfig.scrollSpeedIncreaseRate = worldSpeedIncreaseRate;
+    spawnGenerator.Restart(spawnConfig, static_cast<unsigned int>(RandomEngine()()));
+    ground.Reset();
+    groundDecals.Reset();
     currentState = GameState::PAUSED;
     instructionManager.ResetAllInstructions();
-    // SeekMusicStream(bgmMusic, 0.0f);
-    // PlayMusicStream(bgmMusic);
 }
 
+// 合并一帧更新的输入
+void InputFrame::Merge(const InputFrame& newer)
+{
+    jumpPressed = jumpPressed || newer.jumpPressed;
+    dashPressed = dashPressed || newer.dashPressed;
+    pausePressed = pausePressed || newer.pausePressed;
+    restartPressed = restartPressed || newer.restartPressed;
+    quickSavePressed = quickSavePressed || newer.quickSavePressed;
+    quickLoadPressed = quickLoadPressed || newer.quickLoadPressed;
+    mouseClicked = mouseClicked || newer.mouseClicked;
+    sneakHeld = newer.sneakHeld;
+    moveDirection = newer.moveDirection;
+    virtualMousePos = newer.virtualMousePos;
+}
+
+// 清除按下事件，只保留按住状态
+void InputFrame::ClearPressed()
+{
+    jumpPressed = false;
+    dashPressed = false;
+    pausePressed = false;
+    restartPressed = false;
+    quickSavePressed = false;
+    quickLoadPressed = false;
+    mouseClicked = false;
+}
+
+// 是否含有按下事件
+bool InputFrame::HasPressed() const
+{
+    return jumpPressed || dashPressed || pausePressed || restartPressed || quickSavePressed || quickLoadPressed ||
+        mouseClicked;
+}
+
+// 采集用户输入并交给模拟线程 (主线程)
 void Game::HandleInput()
 {
     if (IsKeyPressed(KEY_F11))
@@ -228,77 +359,100 @@ void Game::HandleInput()
             isFullscreen = false;
         }
         HandleWindowResize();
+        redrawRequested = true;
     }
 
-    if (IsKeyPressed(KEY_ESCAPE))
+    if (IsKeyPressed(KEY_F3))
+    {
+        showPerformance = !showPerformance;
+        performanceTextTimer = 0.0f;
+        redrawRequested = true;
+    }
+    if (IsKeyPressed(KEY_F7)) // 轮换帧节奏模式
+    {
+        switch (framePacer.GetMode())
+        {
+        case FramePacingMode::CAPPED:
+            SetFramePacing(FramePacingMode::VSYNC, framePacer.GetTargetFps());
+            break;
+        case FramePacingMode::VSYNC:
+            SetFramePacing(FramePacingMode::UNCAPPED, framePacer.GetTargetFps());
+            break;
+        case FramePacingMode::UNCAPPED:
+            SetFramePacing(FramePacingMode::CAPPED, framePacer.GetTargetFps());
+            break;
+        }
+        redrawRequested = true;
+    }
+
+    InputFrame input;
+    input.jumpPressed = IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W);
+    input.dashPressed = IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT);
+    input.pausePressed = IsKeyPressed(KEY_ESCAPE);
+    input.restartPressed = IsKeyPressed(KEY_R);
+    input.quickSavePressed = IsKeyPressed(KEY_F5);
+    input.quickLoadPressed = IsKeyPressed(KEY_F9);
+    input.mouseClicked = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+    input.sneakHeld = IsKeyDown(KEY_S);
+    if (IsKeyDown(KEY_D)) input.moveDirection += 1.0f;
+    if (IsKeyDown(KEY_A)) input.moveDirection -= 1.0f;
+    input.virtualMousePos = GetVirtualMousePosition();
+    if (input.HasPressed())
+    {
+        idleSettleTimer = IDLE_SETTLE_TIME;
+    }
+
+    // 模拟线程跟不上导致队列满时先累积在本地，下一帧再入队，按下事件不会丢失
+    pendingInput.Merge(input);
+    if (inputFrames.TryPush(pendingInput))
+    {
+        pendingInput = InputFrame{};
+    }
+}
+
+// 执行一帧输入对应的游戏逻辑 (模拟线程)
+void Game::ApplyInput(const InputFrame& input, const float deltaTime)
+{
+    if (input.pausePressed)
     {
         if (currentState == GameState::PLAYING)
         {
             currentState = GameState::PAUSED;
-            if (IsMusicStreamPlaying(bgmMusic))
-            {
-                PauseMusicStream(bgmMusic);
-            }
+            AudioSystem::PauseMusic();
         }
         else if (currentState == GameState::PAUSED)
         {
             currentState = GameState::PLAYING;
-            ResumeMusicStream(bgmMusic);
+            AudioSystem::ResumeMusic();
         }
     }
 
-    if (currentState == GameState::PAUSED)
+    if (currentState == GameState::PAUSED && input.mouseClicked)
     {
-        Vector2 virtualMousePos = {0, 0};
-        const auto [x, y] = GetMousePosition();
-        // 将原始鼠标坐标转换为虚拟屏幕坐标
-        virtualMousePos.x = (x - destRec.x) / (destRec.width / virtualScreenWidth);
-        virtualMousePos.y = (y - destRec.y) / (destRec.height / virtualScreenHeight);
-
-        constexpr float buttonWidth = 220;
-        constexpr float buttonHeight = 50;
-        constexpr float buttonSpacing = 20;
-        const float restartButtonY = virtualScreenHeight * 0.45f;
-
-        const Rectangle current_restartButtonRect = {
-            virtualScreenWidth / 2.0f - buttonWidth / 2.0f,
-            restartButtonY,
-            buttonWidth,
-            buttonHeight
-        };
-        const Rectangle current_exitButtonRect = {
-            virtualScreenWidth / 2.0f - buttonWidth / 2.0f,
-            current_restartButtonRect.y + buttonHeight + buttonSpacing,
-            buttonWidth,
-            buttonHeight
-        };
-        if (CheckCollisionPointRec(virtualMousePos, current_restartButtonRect))
+        switch (menuLayout.HitTest(input.virtualMousePos))
         {
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                ResetGame();
-            }
-        }
-        if (CheckCollisionPointRec(virtualMousePos, current_exitButtonRect))
-        {
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                CloseWindow();
-            }
+        case MenuButton::RESTART:
+            ResetGame();
+            break;
+        case MenuButton::QUIT:
+            quitRequested.store(true); // 窗口只能由主线程关闭
+            break;
+        default:
+            break;
         }
     }
 
     if (currentState == GameState::PLAYING)
     {
-        if (IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W))
+        if (input.jumpPressed)
         {
             dino->RequestJump();
         }
-        if (IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT))
+        if (input.dashPressed)
         {
             dino->RequestDash();
         }
-        if (IsKeyDown(KEY_S))
+        if (input.sneakHeld)
         {
             dino->StartSneaking();
         }
@@ -306,119 +460,114 @@ void Game::HandleInput()
         {
             dino->StopSneaking();
         }
-        float moveDirection = 0.0f;
-        if (IsKeyDown(KEY_D)) moveDirection += 1.0f;
-        if (IsKeyDown(KEY_A)) moveDirection -= 1.0f;
-        dino->Move(moveDirection, GetFrameTime());
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && playerSword)
+        dino->Move(input.moveDirection, deltaTime);
+        if (input.mouseClicked && playerSword)
         {
             playerSword->Attack();
         }
     }
+    else if (currentState == GameState::GAME_OVER && input.restartPressed)
+    {
+        ResetGame();
+    }
+
+    if (input.quickSavePressed) // 快速存档
+    {
+        SaveSnapshot(quickSaveSnapshot);
+    }
+    if (input.quickLoadPressed && !quickSaveSnapshot.empty()) // 快速读档
+    {
+        LoadSnapshot(quickSaveSnapshot);
+    }
 }
 
 void Game::UpdateGame(const float deltaTime)
 {
-    instructionManager.Update(deltaTime, currentWorldScrollSpeed, timePlayed);
     if (currentState == GameState::GAME_OVER || currentState == GameState::PAUSED)
     {
+        instructionManager.Update(deltaTime, currentWorldScrollSpeed, timePlayed);
         birdDeathParticles.Update(deltaTime);
-        if (playerSword) playerSword->Update(deltaTime);
+        if (playerSword) playerSword->Update(deltaTime, *dino);
+        groundDecals.Advance(0.0f); // 路面不动，只收下本步落地的粒子
         return;
     }
     timePlayed += deltaTime;
+    animationTime += deltaTime; // 所有动画的帧都由它算出，不需要逐个推进
     score = static_cast<int>(timePlayed * 10);
 
     // 增加世界滚动速度
     worldBaseScrollSpeed += worldSpeedIncreaseRate * deltaTime;
     currentWorldScrollSpeed = worldBaseScrollSpeed;
 
-    // 更新恐龙和剑的状态
-    dino->Update(deltaTime, currentWorldScrollSpeed);
-    if (playerSword) playerSword->Update(deltaTime);
-
-    if (dino->position.x < 0) dino->position.x = 0; // 防止移出左边界
-    if (dino->position.x + dino->GetWidth() > virtualScreenWidth) // 防止移出右边界
-    {
-        dino->position.x = virtualScreenWidth - dino->GetWidth();
-    }
+    // 教学文本、恐龙、路面、背景、实体和粒子按任务图更新
+    simulationStepTime = deltaTime;
+    simulationGraph.Run(jobSystem);
+    groundDecals.Advance(currentWorldScrollSpeed * deltaTime); // 与路面一起滚动，并收下本步落地的粒子
 
-    UpdateRoadSegments(deltaTime);
-    UpdateClouds(deltaTime);
-    birdDeathParticles.Update(deltaTime);
-
-    for (auto it = obstacles.begin(); it != obstacles.end();)
-    {
-        it->setSpeed(currentWorldScrollSpeed);
-        it->Update(deltaTime);
-        if (it->IsOffScreen()) it = obstacles.erase(it);
-        else ++it;
-    }
-    for (auto it = birds.begin(); it != birds.end();)
-    {
-        const float birdSpeedFactor = randF(0.3f, 2.51f);
-        it->setSpeed(currentWorldScrollSpeed * birdSpeedFactor);
-        it->Update(deltaTime);
-        if (it->IsOffScreen()) it = birds.erase(it);
-        else ++it;
-    }
+    UpdateSpawning(currentWorldScrollSpeed * deltaTime);
 
-    obstacleSpawnTimer += deltaTime;
-    if (obstacleSpawnTimer >= currentObstacleSpawnInterval)
-    {
-        SpawnObstacleOrBird();
-        obstacleSpawnTimer = 0.0f;
-        // 设置下一次生成的随机时间间隔
-        currentObstacleSpawnInterval = randF(minObstacleSpawnInterval, maxObstacleSpawnInterval);
-    }
+    CheckCollisions(); // 检测碰撞
+}
 
-    cloudSpawnTimerValue += deltaTime;
-    if (cloudSpawnTimerValue >= nextCloudSpawnTime)
+// 按滚动距离消费预生成的分块
+void Game::UpdateSpawning(const float scrolledDistance)
+{
+    spawnDistanceRemaining -= scrolledDistance;
+    while (spawnDistanceRemaining <= 0.0f)
     {
-        SpawnCloud();
-        cloudSpawnTimerValue = 0.0f;
-        nextCloudSpawnTime = randF(1, 6); // 设置下一次生成的随机时间
+        if (nextSpawnEventIndex < currentSpawnChunk.eventCount)
+        {
+            SpawnObstacleOrBird(currentSpawnChunk.events[nextSpawnEventIndex], -spawnDistanceRemaining);
+            ++nextSpawnEventIndex;
+        }
+        if (nextSpawnEventIndex >= currentSpawnChunk.eventCount)
+        {
+            // 当前分块用完，取下一个预生成的分块；后台线程落后时推迟到下一帧
+            if (!spawnGenerator.TryPopChunk(currentSpawnChunk)) return;
+            nextSpawnEventIndex = 0;
+            if (currentSpawnChunk.eventCount == 0) continue;
+        }
+        spawnDistanceRemaining += currentSpawnChunk.events[nextSpawnEventIndex].gapBefore;
     }
-
-    CheckCollisions(); // 检测碰撞
 }
 
-// 生成障碍物或鸟
-void Game::SpawnObstacleOrBird()
+// 按生成事件生成障碍物或鸟
+void Game::SpawnObstacleOrBird(const SpawnEvent& event, const float overshoot)
 {
-    float spawnX = static_cast<float>(virtualScreenWidth) + 250.0f + randF(0, 350);
-    if (const int entityTypeRoll = randI(0, 100); entityTypeRoll < 40)
+    const float spawnX = static_cast<float>(virtualScreenWidth) + spawnGeometry.spawnOffsetX - overshoot;
+    if (event.type != SpawnType::BIRD)
     {
-        Texture2D chosenCactusTex;
-        if (const bool preferSmall = (randI(0, 3) != 0 && !smallCactusTextures.empty()) || bigCactusTextures.empty();
+        TextureHandle chosenCactusTex;
+        if (const bool preferSmall = (event.type == SpawnType::SMALL_CACTUS && !smallCactusTextures.empty()) ||
+                bigCactusTextures.empty();
             preferSmall)
-            chosenCactusTex = smallCactusTextures[randI(0, smallCactusTextures.size())];
+            chosenCactusTex = smallCactusTextures[event.variant % smallCactusTextures.size()];
         else if (!bigCactusTextures.empty())
-            chosenCactusTex = bigCactusTextures[randI(0, bigCactusTextures.size())];
-        else if (!smallCactusTextures.empty())
-            chosenCactusTex = smallCactusTextures[randI(0, smallCactusTextures.size())];
+            chosenCactusTex = bigCactusTextures[event.variant % bigCactusTextures.size()];
         else return;
 
-        obstacles.emplace_back(spawnX, groundY, currentWorldScrollSpeed, chosenCactusTex);
+        EntityDesc cactus;
+        cactus.position = {spawnX, groundY + 8.0f - static_cast<float>(TextureLibrary::Get(chosenCactusTex).height)};
+        cactus.frames = {chosenCactusTex, 1};
+        entities.Create(cactusArchetype, cactus);
     }
     else // 生成鸟
     {
-        const float birdSpriteHeight = birdFrames[0].height;
-        float spawnY;
-        float y_spawn_upper_limit = virtualScreenHeight * 0.3f;
-        float y_spawn_lower_limit = groundY - birdSpriteHeight;
-
-        if (y_spawn_upper_limit >= y_spawn_lower_limit)
-        {
-            spawnY = std::min(y_spawn_upper_limit, y_spawn_lower_limit);
-        }
-        else
-        {
-            spawnY = randF(y_spawn_upper_limit, y_spawn_lower_limit);
-        }
-        spawnY = std::max(spawnY, 0.0f);
-        spawnY = std::min(spawnY, groundY - birdSpriteHeight);
-        birds.emplace_back(spawnX, spawnY, currentWorldScrollSpeed, birdFrames);
+        if (birdFrames.empty()) return;
+        // 飞行曲线由生成器决定 (验证器按同一条曲线判断能否通过)，之后的位置只取决于游戏时间
+        EntityDesc bird;
+        bird.flight.path = event.flight;
+        bird.flight.spawnX = spawnX;
+        bird.flight.spawnTime = timePlayed;
+        bird.flight.spawnScrollSpeed = currentWorldScrollSpeed;
+        bird.flight.baseHeight = event.heightFactor;
+        bird.flight.highestTop = spawnGeometry.BirdTopY(0.0f);
+        bird.flight.lowestTop = spawnGeometry.BirdTopY(1.0f);
+        bird.position = bird.flight.PositionAt(timePlayed, worldSpeedIncreaseRate);
+        bird.frames = birdFrames;
+        bird.clip = birdFlapClip;
+        bird.animationPhase = -animationTime; // 从第一帧开始扇翅
+        entities.Create(birdArchetype, bird);
     }
 }
 
@@ -428,25 +577,14 @@ void Game::CheckCollisions()
     const Rectangle dinoRect = dino->GetCollisionRect(); // 获取恐龙的碰撞框
     bool dinoHitSomething = false;
 
-    for (const auto& obs : obstacles)
-    {
-        if (CheckCollisionRecs(dinoRect, obs.GetCollisionRect()))
-        {
-            dinoHitSomething = true;
-            break;
-        }
-    }
-    if (!dinoHitSomething)
+    entities.ForEach(Component::COLLIDER | Component::LETHAL, [&](const Archetype& archetype)
     {
-        for (const auto& brd : birds)
+        for (const Rectangle& collider : archetype.colliders)
         {
-            if (CheckCollisionRecs(dinoRect, brd.GetCollisionRect()))
-            {
-                dinoHitSomething = true;
-                break;
-            }
+            if (dinoHitSomething) return;
+            dinoHitSomething = CheckCollisionRecs(dinoRect, collider);
         }
-    }
+    });
     if (!dinoHitSomething)
     {
         for (const auto& instructionRect : instructionManager.GetAllActiveCollidableInstructionRects())
@@ -460,7 +598,7 @@ void Game::CheckCollisions()
     }
     if (playerSword && playerSword->IsAttacking())
     {
-        playerSword->CheckCollisionsWithBirds(birds, score,
+        playerSword->CheckCollisionsWithBirds(*dino, entities, score,
                                               birdDeathParticles, birdDeathParticleProps,
                                               currentWorldScrollSpeed,
                                               this->screamSound);
@@ -470,182 +608,139 @@ void Game::CheckCollisions()
     {
         currentState = GameState::GAME_OVER;
         dino->MarkAsDead();
-        if (IsMusicStreamPlaying(bgmMusic))
-        {
-            StopMusicStream(bgmMusic);
-        }
-        PlaySound(deadSound);
+        AudioSystem::StopMusic();
+        musicStarted = false;
+        AudioSystem::Play(deadSound);
     }
 }
 
-// 绘制游戏画面
-void Game::DrawGame() const
+// 收集记录绘制命令所需的资源与界面状态
+RenderInputs Game::MakeRenderInputs() const
 {
-    BeginTextureMode(targetRenderTexture);
-    ClearBackground(RAYWHITE);
-    for (const auto& cloud : activeClouds)
-    {
-        cloud.Draw();
-    }
-    for (const auto& [texture, xPosition] : activeRoadSegments)
-    {
-        DrawTexture(texture, static_cast<int>(xPosition), static_cast<int>(groundY), WHITE);
-    }
-    if (dino)
-    {
-        dino->Draw();
-        // 绘制冷却条
-        if (playerSword && playerSword->IsOnCooldown())
-        {
-            const float dinoDrawX = dino->position.x;
-            const float dinoDrawY = dino->position.y;
-            const float dinoDrawWidth = dino->GetWidth();
-            const float cdBarMaxWidth = dinoDrawWidth * 0.7f;
-            constexpr float cdBarHeight = 7.0f;
-            constexpr float cdBarOffsetY = 12.0f;
-            const float cooldownProgress = playerSword->GetCooldownProgress();
-            const float currentCDBarWidth = cdBarMaxWidth * cooldownProgress;
-
-            // 冷却条背景位置
-            const Vector2 cdBarBgPosition = {
-                dinoDrawX + (dinoDrawWidth / 2.0f) - (cdBarMaxWidth / 2.0f),
-                dinoDrawY - cdBarHeight - cdBarOffsetY
-            };
-            // 冷却条背景
-            DrawRectangleV(cdBarBgPosition, {cdBarMaxWidth, cdBarHeight}, Fade(DARKGRAY, 0.75f));
-            // 冷却进度条
-            DrawRectangleV(cdBarBgPosition, {currentCDBarWidth, cdBarHeight}, LIGHTGRAY);
-            // 边框
-            DrawRectangleLinesEx({cdBarBgPosition.x, cdBarBgPosition.y, cdBarMaxWidth, cdBarHeight}, 1.0f, BLACK);
-        }
-    }
-    for (const auto& obs : obstacles)
+    RenderInputs inputs;
+    inputs.viewport = {0.0f, 0.0f, static_cast<float>(virtualScreenWidth), static_cast<float>(virtualScreenHeight)};
+    inputs.background = &background;
+    inputs.ground = &ground;
+    inputs.groundDecals = &groundDecals;
+    inputs.scoreText = &hudScore.layout;
+    inputs.timeText = &hudTime.layout;
+    if (showPerformance)
     {
-        obs.Draw();
+        inputs.performanceText = &performanceText;
+        inputs.jobPerformanceText = &jobPerformanceText;
     }
-    for (const auto& brd : birds)
+    inputs.gameOverLayer = uiLayers.GetGameOverLayer();
+    inputs.pauseLayer = uiLayers.GetPauseLayer();
+    inputs.uiSource = uiLayers.GetSourceRect();
+    return inputs;
+}
+
+// 显示的分数或时间变化时重新排版抬头显示
+void Game::UpdateHud(const RenderSnapshot& frame)
+{
+    if (hudScore.shownValue != frame.score)
     {
-        brd.Draw();
+        hudScore.shownValue = frame.score;
+        TextLayoutCache::BuildDefault(TextFormat("Score: %06d", frame.score), 30, hudScore.layout);
     }
-    if (playerSword)
+    if (const long long tenths = std::llround(frame.timePlayed * 10.0f); hudTime.shownValue != tenths)
     {
-        playerSword->Draw();
+        hudTime.shownValue = tenths;
+        TextLayoutCache::BuildDefault(TextFormat("Time: %.1fs", static_cast<double>(tenths) / 10.0), 20,
+                                      hudTime.layout);
     }
-    birdDeathParticles.Draw();
-
-    DrawText(TextFormat("Score: %06d", score), 20, 20, 30, DARKGRAY);
-    DrawText(TextFormat("Time: %.1fs", timePlayed),
-             virtualScreenWidth - MeasureText(TextFormat("Time: %.1fs", timePlayed), 20) - 20, 20, 20, DARKGRAY);
-
-    instructionManager.Draw();
-
-    if (currentState == GameState::GAME_OVER)
+    // 性能信息每帧都在变，按固定间隔刷新，数字才看得清
+    if (showPerformance && (performanceTextTimer -= GetFrameTime()) <= 0.0f)
     {
-        DrawText("GAME OVER", virtualScreenWidth / 2 - MeasureText("GAME OVER", 70) / 2, virtualScreenHeight * 0.4f, 70,
-                 RED);
-        DrawText("Press R to Restart",
-                 virtualScreenWidth / 2 - MeasureText("Press R to Restart", 25) / 2,
-                 virtualScreenHeight * 0.6f, 25, DARKGRAY);
-    }
-    else if (currentState == GameState::PAUSED)
-    {
-        DrawRectangle(0, 0, virtualScreenWidth, virtualScreenHeight, Fade(BLACK, 0.8f));
-
-        const auto gameTitleText = "Dino Plus Ultra";
-        constexpr int titleFontSize = 60;
-        const int titleTextWidth = MeasureText(gameTitleText, titleFontSize);
-        DrawText(gameTitleText, virtualScreenWidth / 2 - titleTextWidth / 2, virtualScreenHeight * 0.2f, titleFontSize,
-                 WHITE);
-
-        constexpr float buttonWidth = 220;
-        constexpr float buttonHeight = 50;
-        constexpr int buttonFontSize = 25;
-        constexpr float buttonSpacing = 20;
-
-        Vector2 virtualMousePos = {0, 0};
-        const auto [x, y] = GetMousePosition();
-        virtualMousePos.x = (x - destRec.x) / (destRec.width / virtualScreenWidth);
-        virtualMousePos.y = (y - destRec.y) / (destRec.height / virtualScreenHeight);
+        performanceTextTimer = PERFORMANCE_TEXT_INTERVAL;
+        const FramePacingStats stats = framePacer.GetStats();
+        TextLayoutCache::BuildDefault(TextFormat("%s  %.2f ms  jitter %.3f ms  work %.2f ms  scale %.2f",
+                                                 FramePacer::GetModeName(framePacer.GetMode()),
+                                                 stats.averageFrameTime * 1000.0f, stats.jitter * 1000.0f,
+                                                 stats.workTime * 1000.0f, dynamicResolution.GetScale()),
+                                      10, performanceText);
 
-        const auto restartText = "Restart Game";
-        const Rectangle localRestartButtonRect = {
-            virtualScreenWidth / 2.0f - buttonWidth / 2.0f,
-            virtualScreenHeight * 0.45f,
-            buttonWidth,
-            buttonHeight
-        };
-        Color restartButtonColor = DARKGRAY;
-        if (CheckCollisionPointRec(virtualMousePos, localRestartButtonRect)) // 鼠标悬停时变色
+        // 两张任务图的总耗时、各自最慢的任务、工作线程执行任务的平均时间占比，以及音效发声预算的累计丢弃情况
+        const auto slowest = [](const std::vector<JobTiming>& timings)
         {
-            restartButtonColor = GRAY;
-        }
-        DrawRectangleRec(localRestartButtonRect, restartButtonColor); // 按钮背景
-        DrawRectangleLinesEx(localRestartButtonRect, 2, LIGHTGRAY); // 按钮边框
-        int restartTextWidth = MeasureText(restartText, buttonFontSize);
-        DrawText(restartText, localRestartButtonRect.x + (buttonWidth - restartTextWidth) / 2,
-                 localRestartButtonRect.y + (buttonHeight - buttonFontSize) / 2, buttonFontSize, WHITE);
-
-        const char* exitText = "Quit Game";
-        Rectangle localExitButtonRect = {
-            virtualScreenWidth / 2.0f - buttonWidth / 2.0f,
-            localRestartButtonRect.y + buttonHeight + buttonSpacing,
-            buttonWidth,
-            buttonHeight
+            const auto it = std::ranges::max_element(timings, {}, &JobTiming::duration);
+            return it != timings.end() ? *it : JobTiming{};
         };
-        Color exitButtonColor = DARKGRAY;
-        if (CheckCollisionPointRec(virtualMousePos, localExitButtonRect))
-        {
-            exitButtonColor = GRAY;
-        }
-        DrawRectangleRec(localExitButtonRect, exitButtonColor);
-        DrawRectangleLinesEx(localExitButtonRect, 2, LIGHTGRAY);
-        int exitTextWidth = MeasureText(exitText, buttonFontSize);
-        DrawText(exitText, localExitButtonRect.x + (buttonWidth - exitTextWidth) / 2,
-                 localExitButtonRect.y + (buttonHeight - buttonFontSize) / 2, buttonFontSize, WHITE);
+        const JobTiming slowestSimulation = slowest(frame.simulationJobs);
+        const JobTiming slowestRender = slowest(renderGraph.GetTimings());
+        float busy = 0.0f;
+        const std::vector<WorkerStats> workers = jobSystem.SampleWorkerStats();
+        for (const WorkerStats& worker : workers) busy += worker.busyRatio;
+        if (!workers.empty()) busy /= static_cast<float>(workers.size());
+        TextLayoutCache::BuildDefault(TextFormat("sim %.2f ms (%s %.2f)  render %.2f ms (%s %.2f)  workers %d x %.0f%%"
+                                                 "  sfx stolen %u rejected %u dropped %u",
+                                                 frame.simulationGraphTime, slowestSimulation.name,
+                                                 slowestSimulation.duration, renderGraph.GetLastDuration(),
+                                                 slowestRender.name, slowestRender.duration,
+                                                 jobSystem.GetWorkerCount(), busy * 100.0f,
+                                                 AudioSystem::GetStolenVoiceCount(),
+                                                 AudioSystem::GetRejectedVoiceCount(),
+                                                 AudioSystem::GetDroppedCommandCount()),
+                                      10, jobPerformanceText);
     }
-    EndTextureMode();
-    BeginDrawing();
-    ClearBackground(BLACK); // 清空屏幕背景
-    // 将渲染纹理绘制到屏幕上，并进行缩放和居中
-    DrawTexturePro(targetRenderTexture.texture, sourceRec, destRec, origin, 0.0f, WHITE);
-    EndDrawing();
 }
 
-void Game::SpawnCloud()
+// 设置帧节奏模式，动态分辨率的预算随之改变
+void Game::SetFramePacing(const FramePacingMode mode, const int targetFps)
 {
-    Vector2 initialPosition;
-    initialPosition.x = static_cast<float>(virtualScreenWidth) + randF(50, cloudTexture.width * 2);
-    initialPosition.y = randF(virtualScreenHeight / 8.0f, virtualScreenHeight / 2.0f);
-    float cloudSpeed = randF(15, 45) + currentWorldScrollSpeed * 0.05f;
-    activeClouds.emplace_back(cloudTexture, initialPosition, cloudSpeed);
+    framePacer.SetMode(mode, targetFps);
+    dynamicResolution.SetFrameBudget(framePacer.GetFrameBudget());
 }
 
-void Game::UpdateClouds(const float deltaTime)
+// 绘制一帧世界快照 (主线程)：按任务图并行记录命令，按层和纹理排序后一次提交
+void Game::DrawGame(const RenderSnapshot& frame)
 {
-    for (auto it = activeClouds.begin(); it != activeClouds.end();)
+    dynamicResolution.ReportFrameTime(framePacer.GetLastWorkTime());
+    renderFrame = &frame;
+    renderGraph.Run(jobSystem);
+    renderFrame = nullptr;
+
+    if (RendersDirectly())
     {
-        it->Update(deltaTime);
-        if (it->IsOffScreen())
-        {
-            it = activeClouds.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        renderCommands.Submit();
+        EndDrawing();
+        return;
     }
+
+    // 命令使用虚拟坐标，低分辨率级别用摄像机缩小到渲染纹理上
+    BeginTextureMode(dynamicResolution.GetTarget());
+    ClearBackground(RAYWHITE);
+    BeginMode2D(dynamicResolution.GetCamera());
+    renderCommands.Submit();
+    EndMode2D();
+    EndTextureMode();
+    BeginDrawing();
+    ClearBackground(BLACK); // 清空屏幕背景
+    // 将渲染纹理绘制到屏幕上，并进行缩放和居中
+    DrawTexturePro(dynamicResolution.GetTarget().texture, dynamicResolution.GetSourceRect(), destRec, origin, 0.0f,
+                   WHITE);
+    EndDrawing();
 }
 
 // 重置游戏
 void Game::ResetGame()
 {
-    if (IsMusicStreamPlaying(bgmMusic))
-    {
-        StopMusicStream(bgmMusic);
-    }
+    AudioSystem::StopMusic();
+    musicStarted = false;
     InitGame();
     currentState = GameState::PLAYING;
-    HandleWindowResize();
+}
+
+// 获取鼠标在虚拟屏幕中的坐标
+Vector2 Game::GetVirtualMousePosition() const
+{
+    const auto [x, y] = GetMousePosition();
+    return {
+        (x - destRec.x) / (destRec.width / virtualScreenWidth),
+        (y - destRec.y) / (destRec.height / virtualScreenHeight)
+    };
 }
 
 // 处理窗口大小改变
@@ -660,17 +755,6 @@ void Game::HandleWindowResize()
     screenWidth = GetScreenWidth();
     screenHeight = GetScreenHeight();
     UpdateRenderTextureScaling();
-    groundY = static_cast<float>(virtualScreenHeight) * 0.85f;
-    if (dino)
-    {
-        dino->groundY = groundY;
-        if (dino->IsOnGround() || dino->position.y > groundY - dino->GetHeight())
-        {
-            dino->position.y = groundY - dino->GetHeight() + 5.0f;
-        }
-        dino->UpdateCollisionRect();
-    }
-    InitRoads();
 }
 
 // 更新渲染纹理的缩放参数
@@ -678,93 +762,312 @@ void Game::UpdateRenderTextureScaling()
 {
     const float scale = std::min(static_cast<float>(screenWidth) / virtualScreenWidth,
                                  static_cast<float>(screenHeight) / virtualScreenHeight);
-    destRec.width = virtualScreenWidth * scale;
-    destRec.height = virtualScreenHeight * scale;
-    destRec.x = (static_cast<float>(screenWidth) - destRec.width) / 2.0f;
-    destRec.y = (static_cast<float>(screenHeight) - destRec.height) / 2.0f;
-    sourceRec = {
-        0.0f, 0.0f, static_cast<float>(targetRenderTexture.texture.width),
-        -static_cast<float>(targetRenderTexture.texture.height)
-    };
+    // 目标矩形对齐到整数像素，任何缩放级别下放大后的像素边缘都落在同样的屏幕像素上
+    destRec.width = std::round(virtualScreenWidth * scale);
+    destRec.height = std::round(virtualScreenHeight * scale);
+    destRec.x = std::floor((static_cast<float>(screenWidth) - destRec.width) / 2.0f);
+    destRec.y = std::floor((static_cast<float>(screenHeight) - destRec.height) / 2.0f);
     origin = {0.0f, 0.0f};
 }
 
-void Game::InitRoads()
+// 窗口与虚拟屏幕同样大且使用原始分辨率时直接绘制到屏幕
+bool Game::RendersDirectly() const
 {
-    activeRoadSegments.clear();
-    float currentX = 0.0f;
-    while (currentX < virtualScreenWidth * 1.5f)
+    return screenWidth == virtualScreenWidth && screenHeight == virtualScreenHeight &&
+        dynamicResolution.GetLevel() == 0;
+}
+
+// 快照格式标识与版本，格式改变时递增版本号
+constexpr unsigned int SNAPSHOT_MAGIC = 0x4F4E4944; // "DINO"
+constexpr unsigned int SNAPSHOT_VERSION = 7;
+
+// 把完整的模拟状态写入一块连续快照
+void Game::SaveSnapshot(WorldSnapshot& snapshot) const
+{
+    snapshot.clear();
+    SnapshotWriter writer(snapshot);
+    writer.Write(SNAPSHOT_MAGIC);
+    writer.Write(SNAPSHOT_VERSION);
+
+    writer.Write(currentState);
+    writer.Write(groundY);
+    writer.Write(timePlayed);
+    writer.Write(animationTime);
+    writer.Write(score);
+    writer.Write(worldBaseScrollSpeed);
+    writer.Write(currentWorldScrollSpeed);
+    writer.Write(spawnGenerator.GetSeed());
+    writer.Write(currentSpawnChunk);
+    writer.Write(nextSpawnEventIndex);
+    writer.Write(spawnDistanceRemaining);
+    writer.Write(RandomEngine());
+
+    dino->SaveState(writer);
+    dashTrailParticles.SaveState(writer);
+    playerSword->SaveState(writer);
+    entities.SaveState(writer);
+    background.SaveState(writer);
+    writer.Write(ground.GetState());
+
+    writer.Write(birdDeathParticleProps);
+    birdDeathParticles.SaveState(writer);
+    instructionManager.SaveState(writer);
+}
+
+// 从快照恢复模拟状态
+bool Game::LoadSnapshot(const WorldSnapshot& snapshot)
+{
+    SnapshotReader reader(snapshot);
+    unsigned int magic = 0;
+    unsigned int version = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
     {
-        const int randIdx = randI(0, roadSegmentTextures.size());
-        const Texture2D chosenRoadTex = roadSegmentTextures[randIdx];
-        activeRoadSegments.push_back({chosenRoadTex, currentX}); // 添加到活动路面队列
-        currentX += chosenRoadTex.width;
+        return false; // 还没有读取任何状态，当前这局保持不变
     }
+
+    reader.Read(currentState);
+    reader.Read(groundY);
+    reader.Read(timePlayed);
+    reader.Read(animationTime);
+    reader.Read(score);
+    reader.Read(worldBaseScrollSpeed);
+    reader.Read(currentWorldScrollSpeed);
+    unsigned int spawnSeed = 0;
+    reader.Read(spawnSeed);
+    reader.Read(currentSpawnChunk);
+    reader.Read(nextSpawnEventIndex);
+    reader.Read(spawnDistanceRemaining);
+    reader.Read(RandomEngine());
+
+    dino->LoadState(reader);
+    dashTrailParticles.LoadState(reader);
+    playerSword->LoadState(reader);
+    const bool entitiesValid = entities.LoadState(reader);
+    background.LoadState(reader);
+    GroundStripState groundState;
+    reader.Read(groundState);
+    ground.SetState(groundState);
+    groundDecals.Reset(); // 印记只是画面效果，不进存档，读档时清空
+
+    reader.Read(birdDeathParticleProps);
+    birdDeathParticles.LoadState(reader);
+    instructionManager.LoadState(reader);
+
+    // 快照损坏时状态已不完整，重新开始一局
+    if (!entitiesValid || !reader.IsValid() || !reader.IsAtEnd())
+    {
+        InitGame();
+        return false;
+    }
+    // 分块由种子和序号决定，从当前分块之后重新开始后台生成即可还原后续内容
+    spawnGenerator.Restart(spawnGenerator.GetConfig(), spawnSeed, currentSpawnChunk);
+    return true;
 }
 
-// 更新滚动路面
-void Game::UpdateRoadSegments(const float deltaTime)
+// 进入游戏状态时开始背景音乐 (模拟线程)，填充音乐流由音频线程负责
+void Game::UpdateMusic()
 {
-    for (auto& [texture, xPosition] : activeRoadSegments)
+    if (currentState == GameState::PLAYING && !musicStarted)
     {
-        xPosition -= currentWorldScrollSpeed * deltaTime;
+        AudioSystem::PlayMusic();
+        musicStarted = true;
     }
-    while (!activeRoadSegments.empty() && (activeRoadSegments.front().xPosition + activeRoadSegments.front().texture.
-        width) < 0)
+}
+
+// 把当前世界状态复制到三缓冲的后缓冲并发布 (复用缓冲中已有的容量)
+void Game::PublishRenderSnapshot()
+{
+    RenderSnapshot& frame = renderSnapshots.WriteBuffer();
+    frame.state = currentState;
+    frame.groundY = groundY;
+    frame.timePlayed = timePlayed;
+    frame.animationTime = animationTime;
+    frame.score = score;
+    frame.dino = dino;
+    frame.playerSword = playerSword;
+    frame.entities = entities;
+    frame.background = background.GetState();
+    frame.ground = ground.GetState();
+    frame.groundDecals = groundDecals.GetState();
+    // 粒子池在压力模式下有上百万个粒子，只复制激活的部分
+    dashTrailParticles.CopyActiveTo(frame.dashTrailParticles);
+    birdDeathParticles.CopyActiveTo(frame.birdDeathParticles);
+    frame.instructionManager = instructionManager;
+    frame.simulationJobs = simulationGraph.GetTimings();
+    frame.simulationGraphTime = simulationGraph.GetLastDuration();
+    renderSnapshots.Publish();
+}
+
+// 模拟线程主循环：以固定频率消费输入、更新世界并发布快照
+void Game::SimulationLoop()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / SIMULATION_TICK_RATE));
+    auto previousTick = Clock::now();
+    auto nextTick = previousTick + tickDuration;
+    while (simulationRunning.load())
     {
-        activeRoadSegments.pop_front();
+        const auto now = Clock::now();
+        const float deltaTime = std::min(std::chrono::duration<float>(now - previousTick).count(),
+                                         MAX_SIMULATION_STEP);
+        previousTick = now;
+
+        if (simulationPauseRequested.load(std::memory_order_acquire))
+        {
+            WaitWhileSimulationPaused();
+            previousTick = Clock::now(); // 停下的时间不计入下一步
+            nextTick = previousTick;
+        }
+        AudioSystem::BeginTick();
+        // 取出主线程的所有新输入，按下事件只在这一步生效
+        simulationInput.ClearPressed();
+        InputFrame newerInput;
+        while (inputFrames.TryPop(newerInput))
+        {
+            simulationInput.Merge(newerInput);
+        }
+
+        UpdateMusic();
+        const bool wasPlaying = currentState == GameState::PLAYING;
+        ApplyInput(simulationInput, deltaTime);
+        if (currentState == GameState::PLAYING)
+        {
+            UpdateGame(deltaTime);
+        }
+        // 暂停和结束时世界是静止的，只有输入改变了内容才发布，渲染线程据此进入空闲
+        if (wasPlaying || currentState == GameState::PLAYING || simulationInput.HasPressed())
+        {
+            PublishRenderSnapshot();
+        }
+
+        // 落后时不追赶，直接从现在开始计下一步
+        nextTick = std::max(nextTick, now) + tickDuration;
+        std::this_thread::sleep_until(nextTick);
     }
-    float rightmostX = 0.0f;
-    rightmostX = activeRoadSegments.back().xPosition + activeRoadSegments.back().texture.width;
+}
+
+// 这一帧是否需要重画
+bool Game::NeedsRedraw(const RenderSnapshot& frame, const bool freshSnapshot) const
+{
+    if (frame.state == GameState::PLAYING || freshSnapshot || redrawRequested) return true;
+    return frame.state == GameState::PAUSED &&
+        !uiLayers.IsPauseLayerCurrent(menuLayout.HitTest(GetVirtualMousePosition()));
+}
 
-    while (rightmostX < virtualScreenWidth * 1.5f)
+// 空闲时等待事件：刚按过键时按帧间隔轮询，等模拟线程发布处理结果；否则阻塞到下一个输入或窗口事件
+void Game::WaitForIdleEvents()
+{
+    if (idleSettleTimer > 0.0f)
+    {
+        const float waitTime = framePacer.GetFrameBudget();
+        WaitTime(waitTime);
+        idleSettleTimer -= waitTime;
+        PollInputEvents();
+    }
+    else
     {
-        const int randIdx = randI(0, roadSegmentTextures.size());
-        const Texture2D chosenRoadTex = roadSegmentTextures[randIdx];
-        activeRoadSegments.push_back({chosenRoadTex, rightmostX});
-        rightmostX += chosenRoadTex.width;
+        EnableEventWaiting();
+        PollInputEvents(); // 开启事件等待时会阻塞到有事件为止
+        DisableEventWaiting();
     }
+    framePacer.SkipIdleTime();
 }
 
-void Game::Run()
+// 停止并等待模拟线程
+void Game::StopSimulation()
+{
+    simulationRunning.store(false);
+    if (simulationThread.joinable())
+    {
+        simulationThread.join();
+    }
+}
+
+// 让模拟线程在步与步之间停下并等待它停下
+void Game::PauseSimulation()
+{
+    std::unique_lock lock(simulationPauseMutex);
+    simulationPauseRequested.store(true, std::memory_order_release);
+    simulationPauseCondition.wait(lock, [this] { return simulationPaused || !simulationThread.joinable(); });
+}
+
+// 让停下的模拟线程继续
+void Game::ResumeSimulation()
 {
-    while (!WindowShouldClose())
     {
-        if (bgmMusic.frameCount > 0 && IsAudioDeviceReady())
+        std::lock_guard lock(simulationPauseMutex);
+        simulationPauseRequested.store(false, std::memory_order_release);
+    }
+    simulationPauseCondition.notify_all();
+}
+
+// 模拟线程在步边界停下，直到主线程让它继续
+void Game::WaitWhileSimulationPaused()
+{
+    std::unique_lock lock(simulationPauseMutex);
+    simulationPaused = true;
+    simulationPauseCondition.notify_all();
+    simulationPauseCondition.wait(lock, [this] { return !simulationPauseRequested.load(std::memory_order_acquire); });
+    simulationPaused = false;
+}
+
+// 在帧边界替换热重载的资源：模拟线程也读取纹理尺寸，替换纹理时先让它停在步边界
+// 音效交给音频线程替换；实体只保存句柄，下一次使用时就是新资源
+void Game::ApplyAssetReloads()
+{
+    std::vector<ReloadedAsset> assets = assetWatcher.TakePending();
+    const bool hasTextures = std::any_of(assets.begin(), assets.end(), [](const ReloadedAsset& asset)
+    {
+        return asset.kind == AssetKind::TEXTURE;
+    });
+    if (hasTextures) PauseSimulation();
+    for (auto& asset : assets)
+    {
+        if (asset.kind == AssetKind::TEXTURE)
         {
-            if (!IsMusicStreamPlaying(bgmMusic) && currentState == GameState::PLAYING)
-            {
-                PlayMusicStream(bgmMusic);
-            }
-            if (IsMusicStreamPlaying(bgmMusic))
-            {
-                UpdateMusicStream(bgmMusic);
-                if (GetMusicTimePlayed(bgmMusic) >= GetMusicTimeLength(bgmMusic) - 0.1f)
-                {
-                    SeekMusicStream(bgmMusic, 0.0f);
-                }
-            }
+            if (TextureLibrary::Reload(asset.path, asset.image) > 0) TraceLog(LOG_INFO, "ASSET: Reloaded %s", asset.path.c_str());
+            UnloadImage(asset.image);
         }
+        else
+        {
+            AudioSystem::QueueReload(asset.path, asset.wave);
+            TraceLog(LOG_INFO, "ASSET: Reloaded %s", asset.path.c_str());
+        }
+    }
+    if (hasTextures) ResumeSimulation();
+    redrawRequested = true;
+}
 
-        const float deltaTime = GetFrameTime();
-        HandleInput();
-
+// 主线程只负责采集输入和渲染，世界更新在模拟线程中进行
+void Game::Run()
+{
+    simulationRunning.store(true);
+    simulationThread = std::thread(&Game::SimulationLoop, this);
+    while (!WindowShouldClose() && !quitRequested.load())
+    {
         if (IsWindowResized() && !IsWindowMinimized())
         {
             HandleWindowResize();
+            redrawRequested = true;
         }
-
-        if (currentState == GameState::PLAYING)
+        if (assetWatcher.HasPending())
         {
-            UpdateGame(deltaTime);
+            ApplyAssetReloads();
         }
-        else if (currentState == GameState::GAME_OVER)
+        HandleInput();
+        const bool freshSnapshot = renderSnapshots.AcquireLatest();
+        const RenderSnapshot& frame = renderSnapshots.ReadBuffer();
+        if (NeedsRedraw(frame, freshSnapshot))
         {
-            if (IsKeyPressed(KEY_R))
-            {
-                ResetGame();
-            }
+            DrawGame(frame);
+            framePacer.EndFrame();
+            redrawRequested = false;
+        }
+        else
+        {
+            WaitForIdleEvents();
         }
-        DrawGame();
     }
+    StopSimulation();
 }
@@ -0,0 +1,173 @@
+// src/GroundDecalLayer.cpp
+#include "../include/GroundDecalLayer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // 非负取模
+    long long WrapColumn(const long long column, const int ringWidth)
+    {
+        const long long wrapped = column % ringWidth;
+        return wrapped < 0 ? wrapped + ringWidth : wrapped;
+    }
+}
+
+GroundDecalLayer::GroundDecalLayer()
+    : viewWidth(0), ringWidth(0), top(0.0f), height(0), target{}, targetHandle(INVALID_TEXTURE),
+      bakedGeneration(0), bakedCount(0), bakedColumn(0), baked(false)
+{
+}
+
+// 创建环形渲染纹理
+void GroundDecalLayer::Load(const int width, const float bandTop, const int bandHeight)
+{
+    Unload();
+    viewWidth = width;
+    ringWidth = width + RING_MARGIN;
+    top = bandTop;
+    height = bandHeight;
+    target = LoadRenderTexture(ringWidth, height);
+    SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);
+    targetHandle = TextureLibrary::Register(target.texture);
+    baked = false;
+}
+
+// 释放渲染纹理
+void GroundDecalLayer::Unload()
+{
+    if (target.id > 0) UnloadRenderTexture(target);
+    target = {};
+    targetHandle = INVALID_TEXTURE;
+    baked = false;
+}
+
+// 清空所有印记：换一代，渲染端看到新的代时清空纹理
+void GroundDecalLayer::Reset()
+{
+    const std::uint32_t generation = state.generation + 1;
+    state = GroundDecalState{};
+    state.generation = generation;
+    std::lock_guard lock(stampMutex);
+    recorded.clear();
+}
+
+// 记录一批落地粒子
+void GroundDecalLayer::Stamp(const std::vector<GroundDecal>& decals)
+{
+    if (decals.empty()) return;
+    std::lock_guard lock(stampMutex);
+    recorded.insert(recorded.end(), decals.begin(), decals.end());
+}
+
+// 推进滚动距离并把记录的印记换算到环形纹理上
+void GroundDecalLayer::Advance(const float scrolledDistance)
+{
+    state.scrolled += scrolledDistance;
+    std::lock_guard lock(stampMutex);
+    for (const GroundDecal& decal : recorded)
+    {
+        // 旋转后的外接范围不能越过屏幕左边或环的右端，也不能超出条带，否则会写进还在使用的列
+        const float extent = decal.size * 0.7072f;
+        if (decal.position.x - extent < 0.0f || decal.position.x + extent >= static_cast<float>(ringWidth) ||
+            decal.position.y - extent < top || decal.position.y + extent >= top + static_cast<float>(height))
+        {
+            continue;
+        }
+        GroundDecal& stamp = state.stamps[state.stampCount % GroundDecalState::MAX_PENDING];
+        stamp = decal;
+        stamp.position.x = static_cast<float>(std::fmod(decal.position.x + state.scrolled, ringWidth));
+        stamp.position.y = decal.position.y - top;
+        ++state.stampCount;
+    }
+    recorded.clear();
+}
+
+// 清空滚出屏幕左边的列 (它们接下来会从环的右端重新露出)，再画进还没画过的印记
+void GroundDecalLayer::Bake(const GroundDecalState& bakeState)
+{
+    if (target.id == 0) return;
+    const auto column = static_cast<long long>(std::floor(bakeState.scrolled));
+    if (!baked || bakeState.generation != bakedGeneration)
+    {
+        BeginTextureMode(target);
+        ClearBackground(BLANK);
+        EndTextureMode();
+        bakedGeneration = bakeState.generation;
+        bakedCount = 0;
+        bakedColumn = column;
+        baked = true;
+    }
+
+    const std::uint64_t oldest = bakeState.stampCount -
+        std::min<std::uint64_t>(bakeState.stampCount, GroundDecalState::MAX_PENDING);
+    const std::uint64_t first = std::max(bakedCount, oldest);
+    if (first == bakeState.stampCount && column <= bakedColumn) return;
+
+    BeginTextureMode(target);
+    // 先清空再画：清空的列正是右侧预留区的末端，新印记可能刚好落在那里
+    if (column > bakedColumn)
+    {
+        ClearColumns(bakedColumn, std::min<long long>(column - bakedColumn, ringWidth));
+        bakedColumn = column;
+    }
+    for (std::uint64_t i = first; i < bakeState.stampCount; ++i)
+    {
+        DrawStamp(bakeState.stamps[i % GroundDecalState::MAX_PENDING]);
+    }
+    EndTextureMode();
+    bakedCount = bakeState.stampCount;
+}
+
+// 清空路面坐标 [first, first + count) 对应的列，环绕时分两段
+void GroundDecalLayer::ClearColumns(const long long first, const long long count)
+{
+    const auto start = static_cast<int>(WrapColumn(first, ringWidth));
+    const int firstWidth = static_cast<int>(std::min<long long>(count, ringWidth - start));
+    BeginScissorMode(start, 0, firstWidth, height);
+    ClearBackground(BLANK);
+    EndScissorMode();
+    if (count > firstWidth)
+    {
+        BeginScissorMode(0, 0, static_cast<int>(count - firstWidth), height);
+        ClearBackground(BLANK);
+        EndScissorMode();
+    }
+}
+
+// 画一个印记 (与粒子的画法相同)，跨过环的接缝时在另一端再画一次
+void GroundDecalLayer::DrawStamp(const GroundDecal& decal) const
+{
+    const float half = decal.size / 2.0f;
+    const Rectangle rect = {decal.position.x, decal.position.y, decal.size, decal.size};
+    DrawRectanglePro(rect, {half, half}, decal.rotation, decal.color);
+    const float extent = decal.size * 0.7072f;
+    if (decal.position.x + extent > static_cast<float>(ringWidth))
+    {
+        DrawRectanglePro({rect.x - ringWidth, rect.y, rect.width, rect.height}, {half, half}, decal.rotation,
+                         decal.color);
+    }
+    else if (decal.position.x - extent < 0.0f)
+    {
+        DrawRectanglePro({rect.x + ringWidth, rect.y, rect.width, rect.height}, {half, half}, decal.rotation,
+                         decal.color);
+    }
+}
+
+// 从当前滚动位置开始读取一屏宽的列，跨过环的接缝时分两段绘制
+void GroundDecalLayer::Draw(const GroundDecalState& drawState, RenderCommandList& commands) const
+{
+    if (targetHandle == INVALID_TEXTURE) return;
+    const auto start = static_cast<float>(WrapColumn(static_cast<long long>(std::floor(drawState.scrolled)),
+                                                     ringWidth));
+    const float bandHeight = static_cast<float>(height);
+    const float firstWidth = std::min(static_cast<float>(viewWidth), static_cast<float>(ringWidth) - start);
+    commands.AddTexture(RenderLayer::GROUND_DECALS, targetHandle, {start, 0.0f, firstWidth, -bandHeight},
+                        {0.0f, top, firstWidth, bandHeight});
+    if (firstWidth < static_cast<float>(viewWidth))
+    {
+        const float restWidth = static_cast<float>(viewWidth) - firstWidth;
+        commands.AddTexture(RenderLayer::GROUND_DECALS, targetHandle, {0.0f, 0.0f, restWidth, -bandHeight},
+                            {firstWidth, top, restWidth, bandHeight});
+    }
+}
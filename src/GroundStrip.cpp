@@ -0,0 +1,118 @@
+// src/GroundStrip.cpp
+#include "../include/GroundStrip.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <cmath>
+
+GroundStrip::GroundStrip()
+    : stripTexture(INVALID_TEXTURE), viewWidth(0.0f)
+{
+}
+
+// 把一组路面图片横向拼成一张条带纹理
+void GroundStrip::Load(const std::vector<std::string>& paths, const float width)
+{
+    viewWidth = width;
+    state = GroundStripState{};
+    segmentRects.clear();
+    std::vector<Image> images;
+    int stripWidth = 0;
+    int stripHeight = 0;
+    for (const auto& path : paths)
+    {
+        Image image = LoadImage(path.c_str());
+        if (image.data == nullptr || image.width <= 0) continue; // 加载失败的片段直接跳过
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        segmentRects.push_back({
+            static_cast<float>(stripWidth), 0.0f, static_cast<float>(image.width), static_cast<float>(image.height)
+        });
+        stripWidth += image.width;
+        stripHeight = std::max(stripHeight, image.height);
+        images.push_back(image);
+    }
+    if (images.empty())
+    {
+        stripTexture = INVALID_TEXTURE;
+        return;
+    }
+
+    Image strip = GenImageColor(stripWidth, stripHeight, BLANK);
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const Rectangle source = {0.0f, 0.0f, segmentRects[i].width, segmentRects[i].height};
+        ImageDraw(&strip, images[i], source, segmentRects[i], WHITE);
+        UnloadImage(images[i]);
+    }
+    stripTexture = TextureLibrary::LoadFromImage(strip);
+    UnloadImage(strip);
+}
+
+// 用随机片段重新铺满可见宽度
+void GroundStrip::Reset()
+{
+    state = GroundStripState{};
+    if (segmentRects.empty()) return;
+
+    // 最左侧片段最多滚出一整段，所以需要能覆盖 可见宽度 + 最宽片段 的片段数
+    float minWidth = segmentRects.front().width;
+    float maxWidth = minWidth;
+    for (const auto& rect : segmentRects)
+    {
+        minWidth = std::min(minWidth, rect.width);
+        maxWidth = std::max(maxWidth, rect.width);
+    }
+    const int needed = static_cast<int>(std::ceil((viewWidth + maxWidth) / minWidth));
+    state.count = std::clamp(needed, 1, GroundStripState::MAX_SEGMENTS);
+    for (int i = 0; i < state.count; ++i)
+    {
+        state.segments[i] = static_cast<std::uint8_t>(randI(0, static_cast<int>(segmentRects.size())));
+    }
+}
+
+// 向左滚动：平时只有一次加法，片段滚出屏幕时才轮换环形队列
+void GroundStrip::Scroll(const float distance)
+{
+    if (state.count == 0) return;
+    state.scrollOffset += distance;
+    float headWidth = segmentRects[state.segments[state.head]].width;
+    while (state.scrollOffset >= headWidth)
+    {
+        state.scrollOffset -= headWidth;
+        // 滚出的位置变成环的末尾，换一个随机片段
+        state.segments[state.head] = static_cast<std::uint8_t>(randI(0, static_cast<int>(segmentRects.size())));
+        state.head = (state.head + 1) % state.count;
+        headWidth = segmentRects[state.segments[state.head]].width;
+    }
+}
+
+// 按给定状态绘制路面：所有片段来自同一张条带纹理，排序后是同一个批次
+void GroundStrip::Draw(const GroundStripState& stripState, const float y, RenderCommandList& commands) const
+{
+    if (stripState.count == 0 || segmentRects.empty()) return;
+    // 所有片段的偏移小数部分相同，统一向下取整，相邻片段之间不会出现缝隙或重叠
+    const float drawY = std::floor(y);
+    float x = -stripState.scrollOffset;
+    for (int i = 0; i < stripState.count && x < viewWidth; ++i)
+    {
+        const Rectangle& source = segmentRects[stripState.segments[(stripState.head + i) % stripState.count]];
+        commands.AddTexture(RenderLayer::GROUND, stripTexture, source,
+                            {std::floor(x), drawY, source.width, source.height},
+                            {0.0f, 0.0f}, 0.0f, WHITE);
+        x += source.width;
+    }
+}
+
+// 恢复滚动状态
+void GroundStrip::SetState(const GroundStripState& newState)
+{
+    const bool valid = newState.count > 0 && newState.count <= GroundStripState::MAX_SEGMENTS &&
+        newState.head >= 0 && newState.head < newState.count &&
+        std::all_of(newState.segments.begin(), newState.segments.begin() + newState.count,
+                    [this](const std::uint8_t segment) { return segment < segmentRects.size(); });
+    if (!valid)
+    {
+        Reset();
+        return;
+    }
+    state = newState;
+}
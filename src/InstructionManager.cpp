@@ -4,12 +4,12 @@
 #include <algorithm>
 
 InstructionManager::InstructionManager()
-    : screenWidthRef(0), groundYRef(0.0f), bombSoundRef{nullptr}
+    : screenWidthRef(0), groundYRef(0.0f), bombSoundRef(INVALID_SOUND)
 {
 }
 
 // 初始化
-void InstructionManager::Initialize(const int virtualScreenWidth, const float groundY, const Sound& bombSfx)
+void InstructionManager::Initialize(const int virtualScreenWidth, const float groundY, const SoundHandle bombSfx)
 {
     screenWidthRef = virtualScreenWidth;
     groundYRef = groundY;
@@ -114,11 +114,11 @@ void InstructionManager::Update(const float deltaTime, const float worldScrollSp
     }
 }
 
-void InstructionManager::Draw() const
+void InstructionManager::Draw(RenderCommandList& commands) const
 {
     for (const auto& instructionText : activeInstructionTexts)
     {
-        instructionText.Draw();
+        instructionText.Draw(commands);
     }
 }
 
@@ -145,3 +145,36 @@ std::vector<Rectangle> InstructionManager::GetAllActiveCollidableInstructionRect
     }
     return collidableRects;
 }
+
+// 将触发记录与激活中的教学文本写入快照
+void InstructionManager::SaveState(SnapshotWriter& writer) const
+{
+    // 配置表在 Initialize 中固定，std::map 的遍历顺序稳定，只需按顺序写入触发标记
+    for (const auto& pair : instructionConfigs)
+    {
+        writer.Write(pair.second.triggeredThisSession);
+    }
+    writer.Write(activeInstructionTexts.size());
+    for (const auto& instructionText : activeInstructionTexts)
+    {
+        instructionText.SaveState(writer);
+    }
+}
+
+// 从快照恢复教学提示状态
+void InstructionManager::LoadState(SnapshotReader& reader)
+{
+    for (auto& pair : instructionConfigs)
+    {
+        reader.Read(pair.second.triggeredThisSession);
+    }
+    size_t activeCount = 0;
+    if (!reader.Read(activeCount)) return;
+    activeInstructionTexts.clear();
+    for (size_t i = 0; i < activeCount && reader.IsValid(); ++i)
+    {
+        InstructionText restoredText;
+        restoredText.LoadState(reader, bombSoundRef);
+        activeInstructionTexts.push_back(restoredText);
+    }
+}
@@ -1,5 +1,6 @@
 // src/InstructionText.cpp
 #include "../include/InstructionText.h"
+#include "../include/TextLayoutCache.h"
 
 InstructionText::InstructionText()
     : currentState(InstructionTextState::INACTIVE),
@@ -7,8 +8,8 @@ InstructionText::InstructionText()
       textBounds({0, 0, 0, 0}),
       textDrawPosition({0, 0}),
       fallVelocity({0, 0}),
-      displayTime(2.0f), currentTimer(0.0f), gravity(1000.0f), groundReferenceY(0.0f),
-      explosionParticles(300),
+      displayTime(2.0f), currentTimer(0.0f), gravity(1000.0f), groundReferenceY(0.0f), bombSound(INVALID_SOUND),
+      explosionParticles(300, false), // 教学文本随管理器整体复制进渲染快照，压力模式下不扩大粒子池
       explosionDuration(1.0f),
       screenWidthForCentering(960)
 {
@@ -29,7 +30,7 @@ InstructionText::InstructionText()
 
 void InstructionText::Initialize(const char* text, int fs, Color tColor,
                                  float dispTime, float fallGrav, int virtualScreenWidth, float groundYVal,
-                                 const Sound& explosionSfx)
+                                 const SoundHandle explosionSfx)
 {
     message = text;
     fontSize = fs;
@@ -48,9 +49,9 @@ void InstructionText::Initialize(const char* text, int fs, Color tColor,
 // 计算文本的布局
 void InstructionText::CalculateTextLayout(const Vector2 startPos)
 {
-    // 测量文本的宽度和高度
-    const auto [textWidth, textHeight] = MeasureTextEx(GetFontDefault(), message.c_str(), static_cast<float>(fontSize),
-                                                       1);
+    // 测量文本的宽度和高度 (同一段文字只测量一次)
+    const auto [textWidth, textHeight] = TextLayoutCache::Get(message, GetFontDefault(), static_cast<float>(fontSize),
+                                                              1).size;
     textBounds.width = textWidth;
     textBounds.height = textHeight;
     textBounds.x = startPos.x - textBounds.width / 2.0f;
@@ -120,7 +121,7 @@ void InstructionText::Update(const float deltaTime, const float worldScrollSpeed
             fallVelocity.y = 0; // 停止下落
             currentState = InstructionTextState::EXPLODING; // 切换到爆炸状态
             currentTimer = 0.0f; // 重置计时器
-            PlaySound(bombSound);
+            AudioSystem::Play(bombSound);
 
             // 计算爆炸中心点
             const Vector2 explosionCenter = {
@@ -148,16 +149,60 @@ void InstructionText::Update(const float deltaTime, const float worldScrollSpeed
     }
 }
 
-void InstructionText::Draw() const
+void InstructionText::Draw(RenderCommandList& commands) const
 {
     if (currentState == InstructionTextState::DISPLAYING || currentState == InstructionTextState::FALLING)
     {
-        DrawText(message.c_str(), static_cast<int>(textDrawPosition.x), static_cast<int>(textDrawPosition.y),
-                 fontSize,
-                 textColor);
+        const Vector2 drawPosition = {
+            static_cast<float>(static_cast<int>(textDrawPosition.x)),
+            static_cast<float>(static_cast<int>(textDrawPosition.y))
+        };
+        commands.AddTextLayout(RenderLayer::INSTRUCTIONS, commands.LayoutText(message, fontSize), drawPosition,
+                               textColor);
     }
     if (explosionParticles.GetActiveParticlesCount() > 0)
     {
-        explosionParticles.Draw();
+        explosionParticles.Draw(commands, RenderLayer::INSTRUCTION_PARTICLES);
     }
 }
+
+// 将教学文本状态写入快照
+void InstructionText::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(currentState);
+    writer.WriteString(message);
+    writer.Write(fontSize);
+    writer.Write(textColor);
+    writer.Write(textBounds);
+    writer.Write(textDrawPosition);
+    writer.Write(fallVelocity);
+    writer.Write(displayTime);
+    writer.Write(currentTimer);
+    writer.Write(gravity);
+    writer.Write(groundReferenceY);
+    writer.Write(explosionParticleProps);
+    writer.Write(explosionDuration);
+    writer.Write(screenWidthForCentering);
+    explosionParticles.SaveState(writer);
+}
+
+// 从快照恢复教学文本状态
+void InstructionText::LoadState(SnapshotReader& reader, const SoundHandle explosionSfx)
+{
+    reader.Read(currentState);
+    reader.ReadString(message);
+    reader.Read(fontSize);
+    reader.Read(textColor);
+    reader.Read(textBounds);
+    reader.Read(textDrawPosition);
+    reader.Read(fallVelocity);
+    reader.Read(displayTime);
+    reader.Read(currentTimer);
+    reader.Read(gravity);
+    reader.Read(groundReferenceY);
+    reader.Read(explosionParticleProps);
+    reader.Read(explosionDuration);
+    reader.Read(screenWidthForCentering);
+    explosionParticles.LoadState(reader);
+    bombSound = explosionSfx;
+}
@@ -0,0 +1,173 @@
+// src/JobSystem.cpp
+#include "../include/JobSystem.h"
+#include <algorithm>
+
+namespace
+{
+    thread_local int currentWorkerIndex = -1; // 当前线程的工作线程序号
+}
+
+JobSystem::JobSystem(int workerCount)
+    : queuedJobs(0), nextQueue(0), running(true), lastSample(Clock::now())
+{
+    if (workerCount <= 0)
+    {
+        workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 2);
+    }
+    for (int i = 0; i < workerCount; ++i)
+    {
+        queues.push_back(std::make_unique<WorkQueue>());
+        counters.push_back(std::make_unique<WorkerCounters>());
+    }
+    for (int i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(sleepMutex);
+        running.store(false);
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+// 提交任务
+void JobSystem::Submit(const Job& job)
+{
+    const int worker = currentWorkerIndex;
+    const int target = worker >= 0
+                           ? worker
+                           : static_cast<int>(nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+    {
+        std::lock_guard lock(queues[target]->mutex);
+        queues[target]->jobs.push_back(job);
+    }
+    {
+        // 在锁内增加计数，睡眠中的线程检查条件时不会错过
+        std::lock_guard lock(sleepMutex);
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+// 在调用线程上执行一个排队的任务
+bool JobSystem::TryRunOne()
+{
+    Job job{};
+    bool stolen = false;
+    const int preferred = currentWorkerIndex >= 0 ? currentWorkerIndex : 0;
+    if (!Take(preferred, job, stolen)) return false;
+    job.function(job.context, job.index);
+    return true;
+}
+
+// 对每个序号执行 function 并等待全部完成
+void JobSystem::ParallelFor(const int count, void (*function)(void*, int), void* context)
+{
+    if (count <= 0) return;
+    // 等待计数放在调用者的栈上，最后一个任务减到 0 之后不再访问它
+    struct Batch
+    {
+        void (*function)(void*, int);
+        void* context;
+        std::atomic<int> remaining;
+    } batch{function, context, count - 1};
+    const auto runAndSignal = [](void* batchContext, const int index)
+    {
+        auto& owner = *static_cast<Batch*>(batchContext);
+        owner.function(owner.context, index);
+        owner.remaining.fetch_sub(1, std::memory_order_release);
+    };
+    for (int i = 1; i < count; ++i)
+    {
+        Submit({runAndSignal, &batch, i});
+    }
+    function(context, 0);
+    while (batch.remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!TryRunOne()) std::this_thread::yield();
+    }
+}
+
+// 先取自己的队尾，再偷其它队列的队首
+bool JobSystem::Take(const int preferred, Job& job, bool& stolen)
+{
+    if (queuedJobs.load(std::memory_order_acquire) <= 0) return false;
+    const int count = static_cast<int>(queues.size());
+    for (int offset = 0; offset < count; ++offset)
+    {
+        WorkQueue& queue = *queues[(preferred + offset) % count];
+        std::lock_guard lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        if (offset == 0)
+        {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+        stolen = offset != 0;
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// 工作线程主循环：有任务就执行并计时，没有任务时睡眠到有新任务
+void JobSystem::WorkerLoop(const int index)
+{
+    currentWorkerIndex = index;
+    WorkerCounters& counter = *counters[index];
+    while (true)
+    {
+        Job job{};
+        bool stolen = false;
+        if (Take(index, job, stolen))
+        {
+            const auto start = Clock::now();
+            job.function(job.context, job.index);
+            counter.busyNanoseconds.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count(),
+                std::memory_order_relaxed);
+            counter.jobsRun.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) counter.jobsStolen.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        std::unique_lock lock(sleepMutex);
+        wake.wait(lock, [this]
+        {
+            return queuedJobs.load(std::memory_order_acquire) > 0 || !running.load();
+        });
+        if (!running.load()) return;
+    }
+}
+
+// 自上次调用以来各工作线程的统计，读取后清零
+std::vector<WorkerStats> JobSystem::SampleWorkerStats()
+{
+    const auto now = Clock::now();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastSample).count();
+    lastSample = now;
+    std::vector<WorkerStats> stats(counters.size());
+    for (size_t i = 0; i < counters.size(); ++i)
+    {
+        const int64_t busy = counters[i]->busyNanoseconds.exchange(0, std::memory_order_relaxed);
+        stats[i].busyRatio = elapsed > 0 ? static_cast<float>(busy) / static_cast<float>(elapsed) : 0.0f;
+        stats[i].jobsRun = counters[i]->jobsRun.exchange(0, std::memory_order_relaxed);
+        stats[i].jobsStolen = counters[i]->jobsStolen.exchange(0, std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+// 当前线程的工作线程序号
+int JobSystem::CurrentWorker()
+{
+    return currentWorkerIndex;
+}
@@ -1,10 +1,147 @@
 #include "../include/Game.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
-int main()
+// 只读取图片尺寸 (不需要窗口和 GPU)，用于离线验证
+static Vector2 LoadImageSize(const char* path)
 {
+    const Image image = LoadImage(path);
+    const Vector2 size = {static_cast<float>(image.width), static_cast<float>(image.height)};
+    UnloadImage(image);
+    return size;
+}
+
+// 离线批量验证种子：dino --verify-seeds <种子数量> [每个种子的分块数]
+static int VerifySeeds(const int seedCount, const int chunksPerSeed)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    SpawnGeometry geometry;
+    geometry.groundY = geometry.screenHeight * 0.85f;
+    geometry.dinoStartX = geometry.screenWidth / 4.0f;
+    for (int i = 1; i <= 3; ++i)
+        geometry.smallCactusSizes.push_back(
+            LoadImageSize(("assets/images/small_cactus_" + std::to_string(i) + ".png").c_str()));
+    for (int i = 1; i <= 2; ++i)
+        geometry.bigCactusSizes.push_back(
+            LoadImageSize(("assets/images/big_cactus_" + std::to_string(i) + ".png").c_str()));
+    geometry.birdSize = LoadImageSize("assets/images/bird_1.png");
+    geometry.dinoRunSize = LoadImageSize("assets/images/dino_run_1.png");
+    geometry.dinoSneakSize = LoadImageSize("assets/images/dino_sneak_1.png");
+
+    std::vector<unsigned int> seeds;
+    for (int i = 0; i < seedCount; ++i)
+    {
+        seeds.push_back(static_cast<unsigned int>(i));
+    }
+    const PassabilityVerifier verifier(DinoMovementModel{}, geometry);
+    const std::vector<SeedVerificationResult> results = verifier.VerifySeeds(SpawnGeneratorConfig{}, seeds,
+                                                                             chunksPerSeed);
+    int unfairSeeds = 0;
+    int totalChunks = 0;
+    int fallbackChunks = 0;
+    for (const SeedVerificationResult& result : results)
+    {
+        totalChunks += result.chunksChecked;
+        fallbackChunks += result.fallbackChunks;
+        if (result.unfairChunks == 0) continue;
+        ++unfairSeeds;
+        std::printf("seed %u: %d/%d unfair chunks, first at chunk %d (regenerated %d, repaired %d, fallback %d)\n",
+                    result.seed, result.unfairChunks, result.chunksChecked, result.firstUnfairChunk,
+                    result.regeneratedChunks, result.repairedChunks, result.fallbackChunks);
+    }
+    std::printf("%d/%d seeds contain unfair chunks\n", unfairSeeds, seedCount);
+    std::printf("%d/%d chunks replaced by the fallback chunk\n", fallbackChunks, totalChunks);
+    return unfairSeeds == 0 ? 0 : 1;
+}
+
+// 粒子规模报告：dino --particle-scaling [最大粒子数]
+// 从 1024 个粒子开始每次翻倍，测量每帧更新、发布进渲染快照 (只复制激活粒子) 与记录绘制命令的耗时
+// (固定种子，不需要窗口和 GPU)
+static int ReportParticleScaling(const int maxCount)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int measuredFrames = 60; // 每个规模测量的帧数
+    constexpr float frameTime = 1.0f / 160.0f; // 与模拟线程相同的步长
+    constexpr Rectangle viewport = {0, 0, 960, 540}; // 虚拟屏幕
+
+    JobSystem jobs;
+    ParticleSystem::SetJobSystem(&jobs);
+    RenderCommandList commands;
+    ParticleSnapshot snapshot;
+    // 粒子在屏幕中央缓慢散开且不受重力，测量期间既不死亡也不会被剔除
+    ParticleProperties props;
+    props.lifeTimeMin = props.lifeTimeMax = 1000.0f;
+    props.initialSpeedMin = 5.0f;
+    props.initialSpeedMax = 40.0f;
+    props.gravityScaleMin = props.gravityScaleMax = 0.0f;
+
+    std::printf("%10s %12s %12s %12s %12s %12s %12s\n", "particles", "update ms", "update ns/p", "publish ms",
+                "publish ns/p", "draw ms", "draw ns/p");
+    for (int count = 1024; count <= maxCount; count *= 2)
+    {
+        RandomEngine().seed(count);
+        ParticleSystem particles(count);
+        particles.Emit({viewport.width / 2, viewport.height / 2}, count, props);
+
+        double updateSeconds = 0.0;
+        double publishSeconds = 0.0;
+        double drawSeconds = 0.0;
+        for (int frame = 0; frame < measuredFrames; ++frame)
+        {
+            const auto updateStart = Clock::now();
+            particles.Update(frameTime);
+            const auto publishStart = Clock::now();
+            particles.CopyActiveTo(snapshot);
+            const auto drawStart = Clock::now();
+            commands.Begin(viewport);
+            snapshot.Draw(commands, RenderLayer::PARTICLES);
+            const auto drawEnd = Clock::now();
+            updateSeconds += std::chrono::duration<double>(publishStart - updateStart).count();
+            publishSeconds += std::chrono::duration<double>(drawStart - publishStart).count();
+            drawSeconds += std::chrono::duration<double>(drawEnd - drawStart).count();
+        }
+        const double updateMs = updateSeconds * 1000.0 / measuredFrames;
+        const double publishMs = publishSeconds * 1000.0 / measuredFrames;
+        const double drawMs = drawSeconds * 1000.0 / measuredFrames;
+        std::printf("%10d %12.3f %12.2f %12.3f %12.2f %12.3f %12.2f\n", particles.GetActiveParticlesCount(),
+                    updateMs, updateMs * 1.0e6 / count, publishMs, publishMs * 1.0e6 / count, drawMs,
+                    drawMs * 1.0e6 / count);
+    }
+    ParticleSystem::SetJobSystem(nullptr);
+    return 0;
+}
+
+int main(const int argc, char** argv)
+{
+    if (argc >= 3 && std::strcmp(argv[1], "--verify-seeds") == 0)
+    {
+        return VerifySeeds(std::atoi(argv[2]), argc >= 4 ? std::atoi(argv[3]) : 16);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--particle-scaling") == 0)
+    {
+        return ReportParticleScaling(argc >= 3 ? std::atoi(argv[2]) : ParticleSystem::STRESS_POOL_SIZE);
+    }
+    // 粒子压力模式：dino --particle-stress [发射倍数]，所有发射点的数量乘以倍数，粒子池扩大到 1M
+    if (argc >= 2 && std::strcmp(argv[1], "--particle-stress") == 0)
+    {
+        ParticleSystem::SetStressMode(argc >= 3 ? std::atoi(argv[2]) : 100);
+    }
+
     constexpr int initialScreenWidth = 960;
     constexpr int initialScreenHeight = 540;
     Game game(initialScreenWidth, initialScreenHeight, "Dino Plus Ultra");
+    // 帧节奏：dino --pacing <uncapped|vsync|帧率上限>
+    if (argc >= 3 && std::strcmp(argv[1], "--pacing") == 0)
+    {
+        // 切到 CAPPED 时沿用默认帧率上限，与游戏内 F7 轮换一致
+        constexpr int targetFps = FramePacer::DEFAULT_TARGET_FPS;
+        if (std::strcmp(argv[2], "uncapped") == 0) game.SetFramePacing(FramePacingMode::UNCAPPED, targetFps);
+        else if (std::strcmp(argv[2], "vsync") == 0) game.SetFramePacing(FramePacingMode::VSYNC, targetFps);
+        else if (const int fps = std::atoi(argv[2]); fps > 0) game.SetFramePacing(FramePacingMode::CAPPED, fps);
+    }
     game.Run();
     return 0;
 }
@@ -0,0 +1,157 @@
+// src/ParallaxBackground.cpp
+#include "../include/ParallaxBackground.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <cmath>
+
+ParallaxBackground::ParallaxBackground()
+    : viewWidth(0.0f)
+{
+}
+
+// 设置需要覆盖的视口宽度
+void ParallaxBackground::SetViewWidth(const float width)
+{
+    viewWidth = width;
+}
+
+// 移除所有层
+void ParallaxBackground::ClearLayers()
+{
+    configs.clear();
+    textureSizes.clear();
+    drawOrder.clear();
+    state.clear();
+}
+
+// 添加一个视差层并为其预留实例池
+void ParallaxBackground::AddLayer(const ParallaxLayerConfig& config)
+{
+    const Texture2D& texture = TextureLibrary::Get(config.texture);
+    configs.push_back(config);
+    textureSizes.push_back({static_cast<float>(texture.width), static_cast<float>(texture.height)});
+    ParallaxLayerState& layerState = state.emplace_back();
+    layerState.instances.reserve(std::max(config.capacity, 0));
+
+    drawOrder.push_back(static_cast<int>(configs.size()) - 1);
+    std::ranges::stable_sort(drawOrder, std::greater{}, [this](const int index) { return configs[index].depth; });
+}
+
+// 清空所有实例并按配置重新散布初始实例
+void ParallaxBackground::Reset()
+{
+    for (int i = 0; i < static_cast<int>(configs.size()); ++i)
+    {
+        const ParallaxLayerConfig& config = configs[i];
+        ParallaxLayerState& layerState = state[i];
+        layerState.instances.clear();
+        layerState.spawnTimer = 0.0f;
+        layerState.nextSpawnTime = randF(config.spawnIntervalMin, config.spawnIntervalMax);
+        for (int j = 0; j < config.initialCount; ++j)
+        {
+            SpawnInstance(i, randF(0.0f, viewWidth));
+        }
+    }
+}
+
+// 在指定层生成一个实例
+void ParallaxBackground::SpawnInstance(const int layerIndex, const float x)
+{
+    const ParallaxLayerConfig& config = configs[layerIndex];
+    std::vector<ParallaxInstance>& instances = state[layerIndex].instances;
+    if (static_cast<int>(instances.size()) >= config.capacity) return; // 池满，不再扩容
+
+    ParallaxInstance instance;
+    instance.position = {x, randF(config.minY, config.maxY)};
+    instance.driftSpeed = randF(config.driftSpeedMin, config.driftSpeedMax);
+    instance.scale = randF(config.scaleMin, config.scaleMax);
+    instances.push_back(instance);
+}
+
+// 一个实例的绘制宽度
+float ParallaxBackground::InstanceWidth(const int layerIndex, const ParallaxInstance& instance) const
+{
+    return textureSizes[layerIndex].x * instance.scale;
+}
+
+// 按世界滚动速度移动实例，移除离开屏幕的实例并按计时生成新实例
+void ParallaxBackground::Update(const float deltaTime, const float worldScrollSpeed)
+{
+    for (int i = 0; i < static_cast<int>(configs.size()); ++i)
+    {
+        const ParallaxLayerConfig& config = configs[i];
+        ParallaxLayerState& layerState = state[i];
+        const float layerScroll = worldScrollSpeed * config.scrollFactor;
+        for (auto& instance : layerState.instances)
+        {
+            instance.position.x -= (instance.driftSpeed + layerScroll) * deltaTime;
+        }
+        // 保持剩余实例的先后顺序，重叠的实例不会因为移除而突然换层
+        std::erase_if(layerState.instances, [this, i](const ParallaxInstance& instance)
+        {
+            return instance.position.x + InstanceWidth(i, instance) < 0;
+        });
+
+        layerState.spawnTimer += deltaTime;
+        if (layerState.spawnTimer >= layerState.nextSpawnTime)
+        {
+            SpawnInstance(i, viewWidth + randF(config.spawnGapMin, config.spawnGapMax));
+            layerState.spawnTimer = 0.0f;
+            layerState.nextSpawnTime = randF(config.spawnIntervalMin, config.spawnIntervalMax);
+        }
+    }
+}
+
+// 按给定状态绘制所有层：由远到近，每层一个纹理批次
+void ParallaxBackground::Draw(const ParallaxState& drawState, RenderCommandList& commands) const
+{
+    for (size_t order = 0; order < drawOrder.size(); ++order)
+    {
+        const int index = drawOrder[order];
+        if (index >= static_cast<int>(drawState.size())) continue;
+        const Vector2 size = textureSizes[index];
+        commands.BeginTextureBatch(RenderLayer::BACKGROUND, static_cast<uint8_t>(order), configs[index].texture,
+                                   {0.0f, 0.0f, size.x, size.y}, configs[index].tint);
+        for (const auto& [position, driftSpeed, scale] : drawState[index].instances)
+        {
+            commands.AddBatchInstance({
+                std::floor(position.x), std::floor(position.y), size.x * scale, size.y * scale
+            });
+        }
+    }
+}
+
+// 写入快照
+void ParallaxBackground::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(state.size());
+    for (const auto& layerState : state)
+    {
+        writer.WriteVector(layerState.instances);
+        writer.Write(layerState.spawnTimer);
+        writer.Write(layerState.nextSpawnTime);
+    }
+}
+
+// 从快照恢复
+void ParallaxBackground::LoadState(SnapshotReader& reader)
+{
+    size_t layerCount = 0;
+    reader.Read(layerCount);
+    bool valid = reader.IsValid() && layerCount == state.size();
+    std::vector<ParallaxInstance> instances;
+    for (size_t i = 0; valid && i < layerCount; ++i)
+    {
+        float spawnTimer = 0.0f;
+        float nextSpawnTime = 0.0f;
+        reader.ReadVector(instances);
+        reader.Read(spawnTimer);
+        reader.Read(nextSpawnTime);
+        valid = reader.IsValid() && static_cast<int>(instances.size()) <= configs[i].capacity;
+        if (!valid) break;
+        state[i].instances.assign(instances.begin(), instances.end()); // 复制进已预留的池，不改变容量
+        state[i].spawnTimer = spawnTimer;
+        state[i].nextSpawnTime = nextSpawnTime;
+    }
+    if (!valid) Reset();
+}
@@ -1,12 +1,56 @@
 // src/ParticleSystem.cpp
 #include "../include/ParticleSystem.h"
+#include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <cmath>
+#include <numeric>
 
-ParticleSystem::ParticleSystem(const int maxParticlesCount)
-    : poolIndex(0)
+static_assert(ParticleSystem::UPDATE_CHUNK_SIZE * sizeof(Particle) % CACHE_LINE_SIZE == 0,
+              "分块边界必须落在缓存行边界上");
+
+JobSystem* ParticleSystem::jobSystem = nullptr;
+int ParticleSystem::stressEmitMultiplier = 1;
+GroundDecalLayer* ParticleSystem::groundDecals = nullptr;
+
+namespace
+{
+    // 一次并行更新的参数
+    struct ChunkUpdate
+    {
+        ParticleSystem* system; // 更新的粒子系统
+        float deltaTime; // 步长
+    };
+
+    // 批量计算正弦和余弦 (弧度)：没有分支和库调用，编译器可以向量化；误差小于 1e-5
+    void SinCosBlock(const float* radians, float* sines, float* cosines, const int count)
+    {
+        constexpr float pi = 3.14159265f;
+        constexpr float halfPi = pi / 2.0f;
+        constexpr float twoPi = pi * 2.0f;
+        // 先化到 [-pi, pi]，再用 sin(x) = sin(pi - x) 折到 [-pi/2, pi/2]，在这个区间上多项式足够精确
+        const auto sine = [](const float x)
+        {
+            const float turns = x * (1.0f / twoPi);
+            const float reduced = x - twoPi * static_cast<float>(static_cast<int>(turns + (turns >= 0.0f ? 0.5f : -0.5f)));
+            const float folded = std::max(std::min(reduced, pi - reduced), -pi - reduced);
+            const float x2 = folded * folded;
+            return folded * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 *
+                (1.0f / 362880.0f)))));
+        };
+        for (int i = 0; i < count; ++i)
+        {
+            sines[i] = sine(radians[i]);
+            cosines[i] = sine(radians[i] + halfPi);
+        }
+    }
+}
+
+ParticleSystem::ParticleSystem(const int maxParticlesCount, const bool scalesWithStress)
+    : poolIndex(0), activeCount(0)
 {
-    particlesPool.resize(maxParticlesCount);
+    const bool stressed = scalesWithStress && stressEmitMultiplier > 1 && maxParticlesCount > 0;
+    particlesPool.resize(stressed ? STRESS_POOL_SIZE : maxParticlesCount);
     systemGravity = {0, 980.0f};
 }
 
@@ -27,56 +71,159 @@ void ParticleSystem::Reset()
         p.isActive = false;
     }
     poolIndex = 0;
+    activeCount = 0;
 }
 
-// 获取当前激活的粒子数量
-int ParticleSystem::GetActiveParticlesCount() const
+// 设置并行更新使用的调度器
+void ParticleSystem::SetJobSystem(JobSystem* jobs)
 {
-    int count = 0;
-    for (const auto& p : particlesPool)
+    jobSystem = jobs;
+}
+
+// 设置压力模式的发射倍数
+void ParticleSystem::SetStressMode(const int emitMultiplier)
+{
+    stressEmitMultiplier = std::max(1, emitMultiplier);
+}
+
+// 设置落地粒子烘焙进的印记层
+void ParticleSystem::SetGroundDecals(GroundDecalLayer* decals)
+{
+    groundDecals = decals;
+}
+
+// 将粒子池状态写入快照
+void ParticleSystem::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(poolIndex);
+    writer.Write(systemGravity);
+    writer.WriteVector(particlesPool);
+}
+
+// 从快照恢复粒子池状态
+void ParticleSystem::LoadState(SnapshotReader& reader)
+{
+    reader.Read(poolIndex);
+    reader.Read(systemGravity);
+    reader.ReadVector(particlesPool);
+    if (particlesPool.empty() || poolIndex < 0 || poolIndex >= static_cast<int>(particlesPool.size()))
     {
-        if (p.isActive) count++;
+        poolIndex = 0;
     }
-    return count;
+    activeCount = static_cast<int>(std::ranges::count_if(particlesPool, &Particle::isActive));
 }
 
 // 从指定位置发射指定数量的粒子
 void ParticleSystem::Emit(const Vector2 emitterPosition, const int count, const ParticleProperties& props,
                           const float worldScrollSpeedX)
 {
-    for (int i = 0; i < count; ++i) // 发射指定数量的粒子
+    EmitInArea({emitterPosition.x, emitterPosition.y, 0.0f, 0.0f}, count, props, worldScrollSpeedX);
+}
+
+// 在区域内批量发射：每块先整块生成随机数、整块计算速度方向，再直接写入对象池
+void ParticleSystem::EmitInArea(const Rectangle area, const int count, const ParticleProperties& props,
+                                const float worldScrollSpeedX)
+{
+    if (particlesPool.empty()) return;
+    const int poolSize = static_cast<int>(particlesPool.size());
+    // 压力模式下放大发射数量；超过池大小的部分会被同一批后面的粒子覆盖，直接跳过
+    const int emitCount = std::min(count * stressEmitMultiplier, poolSize);
+    const float angleMin = props.emissionAngleMin * DEG2RAD;
+    const float angleRange = (props.emissionAngleMax - props.emissionAngleMin) * DEG2RAD;
+
+    std::array<float, EMIT_BLOCK_SIZE * EMIT_RANDOM_COUNT> random; // 按属性分段存放的 [0, 1) 随机数
+    std::array<float, EMIT_BLOCK_SIZE> angles;
+    std::array<float, EMIT_BLOCK_SIZE> sines;
+    std::array<float, EMIT_BLOCK_SIZE> cosines;
+    for (int emitted = 0; emitted < emitCount; emitted += EMIT_BLOCK_SIZE)
     {
-        auto&
-        [position, velocity, color, size, lifeTime, lifeRemaining, rotation, angularVelocity, gravityEffect,
-            isActive, isOnGround, groundYLevel, groundScrollSpeedX] = particlesPool[poolIndex]; // 从对象池中获取一个粒子 (循环使用)
-        poolIndex = (poolIndex + 1) % particlesPool.size();
-
-        isActive = true;
-        position = emitterPosition;
-        // 生命周期
-        lifeTime = randF(props.lifeTimeMin, props.lifeTimeMax);
-        lifeRemaining = lifeTime; // 剩余生命等于总生命
-        // 根据属性范围随机设置发射角度和速度
-        const float angleRad = randF(props.emissionAngleMin, props.emissionAngleMax) * DEG2RAD; // 角度转弧度
-        const float speed = randF(props.initialSpeedMin, props.initialSpeedMax);
-        velocity.x = cosf(angleRad) * speed; // 计算X方向速度
-        velocity.y = sinf(angleRad) * speed; // 计算Y方向速度
-        size = randF(props.startSizeMin, props.startSizeMax); // 随机大小
-        color = props.startColor; // 设置颜色
-        rotation = 0.0f; // 初始旋转为0
-        angularVelocity = randF(props.angularVelocityMin, props.angularVelocityMax); // 随机角速度
-        gravityEffect = randF(props.gravityScaleMin, props.gravityScaleMax); // 随机重力影响因子
-        isOnGround = false;
-        groundYLevel = props.targetGroundY; // 设置目标地面Y坐标
-        groundScrollSpeedX = -worldScrollSpeedX; // 粒子在地面上时，随世界反向滚动
+        const int blockCount = std::min(EMIT_BLOCK_SIZE, emitCount - emitted);
+        randUnitFloats(random.data(), blockCount * EMIT_RANDOM_COUNT);
+        const float* offsetX = random.data();
+        const float* offsetY = offsetX + blockCount;
+        const float* life = offsetY + blockCount;
+        const float* angle = life + blockCount;
+        const float* speed = angle + blockCount;
+        const float* size = speed + blockCount;
+        const float* spin = size + blockCount;
+        const float* gravity = spin + blockCount;
+
+        for (int i = 0; i < blockCount; ++i) angles[i] = angleMin + angle[i] * angleRange;
+        SinCosBlock(angles.data(), sines.data(), cosines.data(), blockCount);
+
+        for (int i = 0; i < blockCount; ++i)
+        {
+            Particle& p = particlesPool[poolIndex]; // 从对象池中获取一个粒子 (循环使用)
+            poolIndex = poolIndex + 1 == poolSize ? 0 : poolIndex + 1;
+
+            if (!p.isActive) ++activeCount;
+            p.isActive = true;
+            p.position = {area.x + offsetX[i] * area.width, area.y + offsetY[i] * area.height};
+            p.lifeTime = props.lifeTimeMin + life[i] * (props.lifeTimeMax - props.lifeTimeMin);
+            p.lifeRemaining = p.lifeTime; // 剩余生命等于总生命
+            const float initialSpeed = props.initialSpeedMin + speed[i] * (props.initialSpeedMax - props.initialSpeedMin);
+            p.velocity = {cosines[i] * initialSpeed, sines[i] * initialSpeed};
+            p.size = props.startSizeMin + size[i] * (props.startSizeMax - props.startSizeMin);
+            p.color = props.startColor;
+            p.rotation = 0.0f;
+            p.angularVelocity = props.angularVelocityMin +
+                spin[i] * (props.angularVelocityMax - props.angularVelocityMin);
+            p.gravityEffect = props.gravityScaleMin + gravity[i] * (props.gravityScaleMax - props.gravityScaleMin);
+            p.isOnGround = false;
+            p.groundYLevel = props.targetGroundY; // 设置目标地面Y坐标
+            p.groundScrollSpeedX = -worldScrollSpeedX; // 粒子在地面上时，随世界反向滚动
+        }
     }
 }
 
-// 更新所有激活粒子的状态
+// 更新所有激活粒子的状态：激活粒子多时分块并行，否则串行
 void ParticleSystem::Update(const float deltaTime)
 {
-    for (auto& p : particlesPool)
+    const auto poolSize = static_cast<int>(particlesPool.size());
+    if (jobSystem == nullptr || activeCount <= PARALLEL_UPDATE_THRESHOLD || poolSize <= UPDATE_CHUNK_SIZE)
+    {
+        if (chunkSettled.empty()) chunkSettled.resize(1);
+        activeCount = UpdateRange(0, poolSize, deltaTime, chunkSettled[0]);
+        FlushSettled(1);
+        return;
+    }
+
+    const int chunkCount = (poolSize + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+    chunkActiveCounts.resize(chunkCount);
+    if (static_cast<int>(chunkSettled.size()) < chunkCount) chunkSettled.resize(chunkCount);
+    ChunkUpdate update{this, deltaTime};
+    jobSystem->ParallelFor(chunkCount, &ParticleSystem::UpdateChunkJob, &update);
+    activeCount = std::accumulate(chunkActiveCounts.begin(), chunkActiveCounts.end(), 0);
+    FlushSettled(chunkCount);
+}
+
+// 按分块顺序把落地的粒子交给印记层，印记的先后与线程数无关
+void ParticleSystem::FlushSettled(const int chunkCount)
+{
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
     {
+        if (groundDecals != nullptr) groundDecals->Stamp(chunkSettled[chunk]);
+        chunkSettled[chunk].clear();
+    }
+}
+
+// 调度器回调：更新一个分块并记录其中的激活粒子数
+void ParticleSystem::UpdateChunkJob(void* context, const int chunk)
+{
+    const auto& [system, deltaTime] = *static_cast<ChunkUpdate*>(context);
+    const int first = chunk * UPDATE_CHUNK_SIZE;
+    const int last = std::min(first + UPDATE_CHUNK_SIZE, static_cast<int>(system->particlesPool.size()));
+    system->chunkActiveCounts[chunk] = system->UpdateRange(first, last, deltaTime, system->chunkSettled[chunk]);
+}
+
+// 更新 [first, last) 范围内的粒子
+int ParticleSystem::UpdateRange(const int first, const int last, const float deltaTime,
+                                std::vector<GroundDecal>& settled)
+{
+    int active = 0;
+    for (int i = first; i < last; ++i)
+    {
+        Particle& p = particlesPool[i];
         if (!p.isActive) continue;
 
         p.lifeRemaining -= deltaTime; // 减少剩余生命
@@ -105,21 +252,59 @@ void ParticleSystem::Update(const float deltaTime)
             {
                 p.isOnGround = true;
                 p.position.y = p.groundYLevel - p.size / 2.0f;
+                if (groundDecals != nullptr) // 烘焙成印记，粒子槽位立即释放
+                {
+                    settled.push_back({p.position, p.size, p.rotation, p.color});
+                    p.isActive = false;
+                    continue;
+                }
             }
         }
+        ++active;
     }
+    return active;
 }
 
-void ParticleSystem::Draw() const
+void ParticleSystem::Draw(RenderCommandList& commands, const RenderLayer layer) const
 {
     for (const auto& p : particlesPool)
     {
         if (!p.isActive) continue;
-        DrawRectanglePro(
+        commands.AddRectangle(
+            layer,
             {p.position.x, p.position.y, p.size, p.size},
+            p.color,
             {p.size / 2, p.size / 2},
-            p.rotation,
-            p.color
+            p.rotation
+        );
+    }
+}
+
+// 只复制激活粒子，找齐 activeCount 个后提前结束
+void ParticleSystem::CopyActiveTo(ParticleSnapshot& snapshot) const
+{
+    snapshot.sprites.clear();
+    if (activeCount == 0) return;
+    snapshot.sprites.reserve(activeCount);
+    for (const auto& p : particlesPool)
+    {
+        if (!p.isActive) continue;
+        snapshot.sprites.push_back({p.position, p.size, p.rotation, p.color});
+        if (static_cast<int>(snapshot.sprites.size()) == activeCount) break;
+    }
+}
+
+// 把快照中的粒子记录到指定层
+void ParticleSnapshot::Draw(RenderCommandList& commands, const RenderLayer layer) const
+{
+    for (const auto& sprite : sprites)
+    {
+        commands.AddRectangle(
+            layer,
+            {sprite.position.x, sprite.position.y, sprite.size, sprite.size},
+            sprite.color,
+            {sprite.size / 2, sprite.size / 2},
+            sprite.rotation
         );
     }
 }
@@ -0,0 +1,329 @@
+// src/PassabilityVerifier.cpp
+#include "../include/PassabilityVerifier.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+namespace
+{
+    // 搜索中的一个恐龙状态 (与 Dinosaur 中影响碰撞的成员一一对应)
+    struct DinoSearchState
+    {
+        float x = 0.0f; // 左上角X
+        float y = 0.0f; // 左上角Y
+        float velocityY = 0.0f; // 竖直速度
+        bool sneaking = false; // 是否潜行
+        bool dashing = false; // 是否冲刺中
+        int dashSteps = -1; // 冲刺开始后经过的步数 (-1 表示冷却完毕)
+        float dashDirection = 1.0f; // 冲刺方向
+    };
+
+    // 搜索前沿中的节点，key 是量化后的状态，相同 key 的节点会被合并
+    struct SearchNode
+    {
+        uint64_t key;
+        DinoSearchState state;
+    };
+
+    // 按滚动距离出现的障碍物
+    struct TimedObstacle
+    {
+        float spawnDistance; // 出现时世界已滚动的距离
+        float spawnX; // 出现时的屏幕X坐标
+        float top; // 顶部Y坐标 (鸟为高度系数0时的顶部)
+        Vector2 size; // 尺寸
+        float speedFactor; // 相对世界滚动速度的倍数
+        bool flies; // 是否按飞行曲线改变高度
+        float baseHeight; // 鸟出生时的高度系数
+        float lowestTop; // 鸟的高度系数为1时的顶部Y坐标
+        FlightPath flight; // 鸟的飞行曲线
+    };
+}
+
+PassabilityVerifier::PassabilityVerifier(const DinoMovementModel& movementModel, const SpawnGeometry& spawnGeometry,
+                                         const PassabilitySearchSettings& searchSettings)
+    : movement(movementModel), geometry(spawnGeometry), settings(searchSettings)
+{
+}
+
+// 判断从站在地面开始，这串生成事件是否可以通过
+bool PassabilityVerifier::IsPassable(const SpawnEvent* events, const int eventCount,
+                                     const float startScrollSpeed, const float scrollSpeedIncreaseRate) const
+{
+    if (eventCount <= 0) return true;
+
+    // 把生成事件换算成按滚动距离出现的障碍物
+    std::vector<TimedObstacle> obstacles;
+    obstacles.reserve(eventCount);
+    const float spawnX = geometry.screenWidth + geometry.spawnOffsetX;
+    float distance = 0.0f;
+    float endDistance = 0.0f;
+    for (int i = 0; i < eventCount; ++i)
+    {
+        const SpawnEvent& event = events[i];
+        distance += event.gapBefore;
+        TimedObstacle obstacle{distance, spawnX, 0.0f, {0, 0}, 1.0f, false, 0.0f, 0.0f, FlightPath{}};
+        if (event.type == SpawnType::BIRD)
+        {
+            // 与 Game::SpawnObstacleOrBird 使用同一条飞行曲线
+            obstacle.size = geometry.birdSize;
+            obstacle.top = geometry.BirdTopY(0.0f);
+            obstacle.speedFactor = event.flight.speedFactor;
+            obstacle.flies = true;
+            obstacle.baseHeight = event.heightFactor;
+            obstacle.lowestTop = geometry.BirdTopY(1.0f);
+            obstacle.flight = event.flight;
+        }
+        else
+        {
+            obstacle.size = geometry.CactusSize(event.type, event.variant);
+            obstacle.top = geometry.groundY + 8.0f - obstacle.size.y; // 与 Game::SpawnObstacleOrBird 中仙人掌的位置一致
+        }
+        if (obstacle.size.x <= 0.0f || obstacle.speedFactor <= 0.0f) continue;
+        obstacles.push_back(obstacle);
+        endDistance = std::max(endDistance, distance + (spawnX + obstacle.size.x) / obstacle.speedFactor);
+    }
+
+    const float dt = settings.timeStep;
+    const DinoMovementModel& m = movement;
+    const float groundY = geometry.groundY;
+    auto height = [&](const DinoSearchState& s) { return s.sneaking ? geometry.dinoSneakSize.y : geometry.dinoRunSize.y; };
+    auto width = [&](const DinoSearchState& s) { return s.sneaking ? geometry.dinoSneakSize.x : geometry.dinoRunSize.x; };
+    auto onGround = [&](const DinoSearchState& s) { return s.y + height(s) >= groundY - m.groundTolerance; };
+    auto dashReady = [&](const DinoSearchState& s)
+    {
+        return !s.dashing && (s.dashSteps < 0 || static_cast<float>(s.dashSteps) * dt >= m.dashCooldown);
+    };
+
+    // 按 Game::HandleInput 和 Dinosaur::Update 的顺序推进一步
+    // 朝向只影响冲刺方向，搜索时直接枚举冲刺方向 (dash 为 -1/1 表示向左/右冲刺)
+    auto advance = [&](DinoSearchState s, const float move, const bool sneak, const bool jump, const int dash)
+    {
+        const bool jumpRequested = jump && !s.dashing;
+        if (dash != 0 && dashReady(s))
+        {
+            s.dashing = true;
+            s.dashSteps = 0;
+            s.dashDirection = static_cast<float>(dash);
+        }
+        if (sneak != s.sneaking)
+        {
+            const bool wasOnGround = onGround(s);
+            const float heightBefore = height(s);
+            s.sneaking = sneak;
+            const float heightAfter = height(s);
+            if (wasOnGround && heightBefore != heightAfter)
+            {
+                s.y += heightBefore - heightAfter;
+                if (!sneak && s.y + heightAfter > groundY + 0.1f) s.y = groundY - heightAfter;
+            }
+        }
+        if (!s.dashing && move != 0.0f)
+        {
+            s.x += move * m.moveSpeed * (s.sneaking ? 0.5f : 1.0f) * dt;
+        }
+
+        if (s.dashSteps >= 0) ++s.dashSteps;
+        if (s.dashing)
+        {
+            if (static_cast<float>(s.dashSteps) * dt >= m.dashDuration) s.dashing = false;
+            else s.x += s.dashDirection * m.dashSpeedMagnitude * dt;
+        }
+        if (!s.dashing)
+        {
+            if (jumpRequested && onGround(s)) s.velocityY = m.jumpSpeed;
+            if (!onGround(s))
+            {
+                const float gravity = s.sneaking ? m.gravity * m.sneakGravityMultiplier : m.gravity;
+                s.velocityY += gravity * dt;
+            }
+        }
+        s.y += s.velocityY * dt;
+        if (onGround(s) && s.velocityY >= 0.0f)
+        {
+            s.velocityY = 0.0f;
+            s.y = groundY - height(s) + m.groundTolerance;
+        }
+        s.x = std::clamp(s.x, 0.0f, geometry.screenWidth - width(s));
+        if (dashReady(s)) s.dashSteps = -1; // 冷却结束后的状态全部等价
+        return s;
+    };
+
+    // 量化状态，用于合并几乎相同的状态
+    auto quantize = [&](const DinoSearchState& s)
+    {
+        const auto xi = static_cast<uint64_t>(std::lround(s.x / settings.positionResolution)) & 0x3FF;
+        const auto yi = static_cast<uint64_t>(std::lround(s.y / settings.heightResolution) + 1024) & 0xFFF;
+        const auto vi = static_cast<uint64_t>(std::lround(s.velocityY / settings.velocityResolution) + 512) & 0x3FF;
+        const auto di = static_cast<uint64_t>(s.dashSteps + 1) & 0xFF;
+        return xi | yi << 10 | vi << 22 | di << 32 |
+            static_cast<uint64_t>(s.sneaking) << 40 | static_cast<uint64_t>(s.dashing) << 41 |
+            static_cast<uint64_t>(s.dashDirection > 0.0f) << 42;
+    };
+
+    auto scrolledDistance = [&](const float t) { return startScrollSpeed * t + 0.5f * scrollSpeedIncreaseRate * t * t; };
+
+    DinoSearchState start;
+    start.x = geometry.dinoStartX;
+    start.y = groundY - geometry.dinoRunSize.y + m.groundTolerance;
+    std::vector<SearchNode> frontier{{quantize(start), start}};
+    std::vector<SearchNode> next;
+    std::vector<Rectangle> obstacleRects;
+
+    const int maxSteps = static_cast<int>(settings.maxSimulatedSeconds / dt);
+    for (int step = 0; step < maxSteps; ++step)
+    {
+        const float d0 = scrolledDistance(static_cast<float>(step) * dt);
+        const float d1 = scrolledDistance(static_cast<float>(step + 1) * dt);
+        if (d0 >= endDistance) return true;
+
+        // 本步内障碍物扫过的区域，避免高速时穿过细小的仙人掌
+        obstacleRects.clear();
+        for (const auto& o : obstacles)
+        {
+            if (d1 < o.spawnDistance) continue;
+            const float flown1 = o.speedFactor * (d1 - o.spawnDistance);
+            const float flown0 = o.speedFactor * (std::max(d0, o.spawnDistance) - o.spawnDistance);
+            const float left1 = o.spawnX - flown1;
+            const float left0 = o.spawnX - flown0;
+            float top0 = o.top;
+            float top1 = o.top;
+            if (o.flies) // 鸟的高度是飞过距离的函数，扫过的区域包含本步首尾两个高度
+            {
+                top0 = o.top + (o.lowestTop - o.top) * o.flight.HeightFactorAt(o.baseHeight, flown0);
+                top1 = o.top + (o.lowestTop - o.top) * o.flight.HeightFactorAt(o.baseHeight, flown1);
+            }
+            const float sweptTop = std::min(top0, top1);
+            const Rectangle swept = {left1, sweptTop, left0 - left1 + o.size.x, std::max(top0, top1) - sweptTop + o.size.y};
+            if (swept.x + swept.width < 0.0f || swept.x > geometry.screenWidth) continue;
+            obstacleRects.push_back(swept);
+        }
+
+        next.clear();
+        for (const auto& [key, state] : frontier)
+        {
+            const bool canJump = onGround(state) && !state.dashing;
+            const bool canDash = dashReady(state);
+            for (int move = -1; move <= 1; ++move)
+            {
+                for (int sneak = 0; sneak <= 1; ++sneak)
+                {
+                    for (int jump = 0; jump <= (canJump ? 1 : 0); ++jump)
+                    {
+                        for (int dash = canDash ? -1 : 0; dash <= (canDash ? 1 : 0); ++dash)
+                        {
+                            const DinoSearchState s = advance(state, static_cast<float>(move), sneak, jump, dash);
+                            const Rectangle body = {s.x, s.y, width(s), height(s)};
+                            const Rectangle hitbox = Dinosaur::ShrinkCollisionRect(body, s.sneaking, s.dashing);
+                            bool hit = false;
+                            for (const auto& rect : obstacleRects)
+                            {
+                                if (CheckCollisionRecs(hitbox, rect))
+                                {
+                                    hit = true;
+                                    break;
+                                }
+                            }
+                            if (!hit) next.push_back({quantize(s), s});
+                        }
+                    }
+                }
+            }
+        }
+        if (next.empty()) return false;
+
+        std::ranges::sort(next, {}, &SearchNode::key);
+        const auto [first, last] = std::ranges::unique(next, {}, &SearchNode::key);
+        next.erase(first, last);
+        // 前沿过大时按 key 顺序等间隔抽样，保留各种高度、位置和冲刺阶段的代表状态
+        // 这是保守的近似：丢弃的状态只会让结果偏向"不可通过"，不会把真正无法通过的序列判为可通过
+        const size_t cap = static_cast<size_t>(std::max(settings.maxFrontierStates, 1));
+        if (next.size() > cap)
+        {
+            const double stride = static_cast<double>(next.size()) / static_cast<double>(cap);
+            for (size_t i = 0; i < cap; ++i)
+            {
+                next[i] = next[static_cast<size_t>(static_cast<double>(i) * stride)];
+            }
+            next.resize(cap);
+        }
+        std::swap(frontier, next);
+    }
+    return true;
+}
+
+// 判断分块是否可以通过
+bool PassabilityVerifier::IsChunkPassable(const SpawnGeneratorConfig& config, const SpawnChunk& chunk,
+                                          const SpawnChunk* previousChunk) const
+{
+    SpawnEvent sequence[MAX_CHUNK_EVENTS * 2];
+    int count = 0;
+    float contextLength = 0.0f;
+    if (previousChunk)
+    {
+        const int contextCount = std::min(settings.contextEvents, previousChunk->eventCount);
+        for (int i = previousChunk->eventCount - contextCount; i < previousChunk->eventCount; ++i)
+        {
+            sequence[count++] = previousChunk->events[i];
+            contextLength += previousChunk->events[i].gapBefore;
+        }
+    }
+    for (int i = 0; i < chunk.eventCount; ++i)
+    {
+        sequence[count++] = chunk.events[i];
+    }
+    const float startSpeed = SpawnGenerator::ScrollSpeedAtDistance(config, chunk.startDistance - contextLength);
+    return IsPassable(sequence, count, startSpeed, config.scrollSpeedIncreaseRate);
+}
+
+// 在多个线程上并行验证一批种子
+std::vector<SeedVerificationResult> PassabilityVerifier::VerifySeeds(const SpawnGeneratorConfig& config,
+                                                                     const std::vector<unsigned int>& seeds,
+                                                                     const int chunksPerSeed,
+                                                                     const unsigned int threadCount) const
+{
+    std::vector<SeedVerificationResult> results(seeds.size());
+    std::atomic<size_t> nextSeedIndex(0);
+
+    auto worker = [&]
+    {
+        for (size_t i = nextSeedIndex.fetch_add(1); i < seeds.size(); i = nextSeedIndex.fetch_add(1))
+        {
+            SeedVerificationResult& result = results[i];
+            result.seed = seeds[i];
+            SpawnChunk previous;
+            for (int c = 0; c < chunksPerSeed; ++c)
+            {
+                ChunkVerification verification = ChunkVerification::UNVERIFIED;
+                const SpawnChunk chunk = SpawnGenerator::BuildVerifiedChunk(config, seeds[i], previous, this,
+                                                                            &verification);
+                if (verification != ChunkVerification::PASSED)
+                {
+                    if (result.firstUnfairChunk < 0) result.firstUnfairChunk = chunk.index;
+                    ++result.unfairChunks;
+                }
+                if (verification == ChunkVerification::REGENERATED) ++result.regeneratedChunks;
+                if (verification == ChunkVerification::REPAIRED) ++result.repairedChunks;
+                if (verification == ChunkVerification::FALLBACK) ++result.fallbackChunks;
+                ++result.chunksChecked;
+                previous = chunk;
+            }
+        }
+    };
+
+    unsigned int workerCount = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min<unsigned int>(workerCount, std::max<size_t>(seeds.size(), 1));
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < workerCount; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+    worker(); // 当前线程也参与验证
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+    return results;
+}
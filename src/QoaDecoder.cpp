@@ -0,0 +1,193 @@
+// src/QoaDecoder.cpp
+#include "../include/QoaDecoder.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+    constexpr size_t FILE_HEADER_SIZE = 8; // "qoaf" + 总采样数
+    constexpr size_t FRAME_HEADER_SIZE = 8; // 声道数、采样率、帧采样数、帧字节数
+    constexpr size_t LMS_STATE_SIZE = 16; // 每声道的预测器历史和权重
+
+    // 反量化表：按规范由缩放因子 (s + 1)^2.75 生成
+    std::array<std::array<int, 8>, 16> BuildDequantTable()
+    {
+        constexpr float STEPS[8] = {0.75f, -0.75f, 2.5f, -2.5f, 4.5f, -4.5f, 7.0f, -7.0f};
+        std::array<std::array<int, 8>, 16> table{};
+        for (int s = 0; s < 16; ++s)
+        {
+            const double scaleFactor = std::round(std::pow(s + 1.0, 2.75));
+            for (int q = 0; q < 8; ++q)
+            {
+                table[s][q] = static_cast<int>(std::lround(scaleFactor * STEPS[q]));
+            }
+        }
+        return table;
+    }
+
+    const std::array<std::array<int, 8>, 16> DEQUANT_TABLE = BuildDequantTable();
+
+    // 一个声道的 LMS 预测器
+    struct LmsState
+    {
+        int history[4];
+        int weights[4];
+
+        int Predict() const
+        {
+            int prediction = 0;
+            for (int i = 0; i < 4; ++i) prediction += weights[i] * history[i];
+            return prediction >> 13;
+        }
+
+        void Update(const int sample, const int residual)
+        {
+            const int delta = residual >> 4;
+            for (int i = 0; i < 4; ++i) weights[i] += history[i] < 0 ? -delta : delta;
+            history[0] = history[1];
+            history[1] = history[2];
+            history[2] = history[3];
+            history[3] = sample;
+        }
+    };
+}
+
+QoaDecoder::QoaDecoder()
+    : channels(0), sampleRate(0), totalFrames(0), position(0), decodedFrame(UINT32_MAX), decodedLength(0)
+{
+}
+
+// 打开内存中的 QOA 文件数据，并用第一帧的头部确定声道数和采样率
+bool QoaDecoder::Open(std::vector<uint8_t> fileData)
+{
+    Close();
+    data = std::move(fileData);
+    if (data.size() < FILE_HEADER_SIZE + FRAME_HEADER_SIZE) return false;
+    const uint64_t fileHeader = ReadU64(0);
+    if ((fileHeader >> 32) != 0x716f6166) return false; // "qoaf"
+    const auto samples = static_cast<uint32_t>(fileHeader & 0xffffffff);
+
+    const uint64_t frameHeader = ReadU64(FILE_HEADER_SIZE);
+    const auto frameChannels = static_cast<uint32_t>(frameHeader >> 56);
+    const auto frameRate = static_cast<uint32_t>((frameHeader >> 32) & 0xffffff);
+    if (samples == 0 || frameChannels == 0 || frameChannels > MAX_CHANNELS || frameRate == 0) return false;
+
+    channels = frameChannels;
+    sampleRate = frameRate;
+    totalFrames = samples;
+    frameSamples.resize(static_cast<size_t>(FRAME_LENGTH) * channels);
+    return true;
+}
+
+// 关闭并释放数据
+void QoaDecoder::Close()
+{
+    data.clear();
+    data.shrink_to_fit();
+    frameSamples.clear();
+    channels = 0;
+    sampleRate = 0;
+    totalFrames = 0;
+    position = 0;
+    decodedFrame = UINT32_MAX;
+    decodedLength = 0;
+}
+
+// 跳到指定采样位置，实际解码推迟到下一次读取
+void QoaDecoder::Seek(const uint32_t frame)
+{
+    position = std::min(frame, totalFrames);
+}
+
+// 读取采样帧，跨帧时逐帧解码
+uint32_t QoaDecoder::Read(int16_t* output, const uint32_t frameCount)
+{
+    uint32_t written = 0;
+    while (written < frameCount && position < totalFrames)
+    {
+        const uint32_t frameIndex = position / FRAME_LENGTH;
+        if (frameIndex != decodedFrame && !DecodeFrame(frameIndex)) break;
+        const uint32_t offset = position - frameIndex * FRAME_LENGTH;
+        if (offset >= decodedLength) break;
+        const uint32_t count = std::min(frameCount - written, decodedLength - offset);
+        std::copy_n(frameSamples.data() + static_cast<size_t>(offset) * channels, static_cast<size_t>(count) * channels,
+                    output + static_cast<size_t>(written) * channels);
+        written += count;
+        position += count;
+    }
+    return written;
+}
+
+// 除最后一帧外每帧大小相同，可以直接算出偏移
+size_t QoaDecoder::FrameOffset(const uint32_t index) const
+{
+    constexpr size_t SLICES_PER_FRAME = FRAME_LENGTH / SLICE_LENGTH;
+    const size_t fullFrameSize = FRAME_HEADER_SIZE + LMS_STATE_SIZE * channels + SLICES_PER_FRAME * 8 * channels;
+    return FILE_HEADER_SIZE + fullFrameSize * index;
+}
+
+// 解码一帧：读取每声道的预测器状态，再按分片还原采样
+bool QoaDecoder::DecodeFrame(const uint32_t index)
+{
+    decodedFrame = UINT32_MAX;
+    size_t offset = FrameOffset(index);
+    if (offset + FRAME_HEADER_SIZE > data.size()) return false;
+    const uint64_t frameHeader = ReadU64(offset);
+    const auto frameChannels = static_cast<uint32_t>(frameHeader >> 56);
+    const auto length = static_cast<uint32_t>((frameHeader >> 16) & 0xffff);
+    const auto frameSize = static_cast<size_t>(frameHeader & 0xffff);
+    const size_t slicesSize = static_cast<size_t>((length + SLICE_LENGTH - 1) / SLICE_LENGTH) * 8 * channels;
+    if (frameChannels != channels || length == 0 || length > FRAME_LENGTH ||
+        frameSize != FRAME_HEADER_SIZE + LMS_STATE_SIZE * channels + slicesSize || offset + frameSize > data.size())
+    {
+        return false;
+    }
+    offset += FRAME_HEADER_SIZE;
+
+    LmsState lms[MAX_CHANNELS];
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        uint64_t history = ReadU64(offset);
+        uint64_t weights = ReadU64(offset + 8);
+        offset += LMS_STATE_SIZE;
+        for (int i = 0; i < 4; ++i)
+        {
+            lms[c].history[i] = static_cast<int16_t>(history >> 48);
+            lms[c].weights[i] = static_cast<int16_t>(weights >> 48);
+            history <<= 16;
+            weights <<= 16;
+        }
+    }
+
+    for (uint32_t sampleIndex = 0; sampleIndex < length; sampleIndex += SLICE_LENGTH)
+    {
+        const uint32_t sliceEnd = std::min(sampleIndex + SLICE_LENGTH, length);
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+            uint64_t slice = ReadU64(offset);
+            offset += 8;
+            const auto& dequant = DEQUANT_TABLE[(slice >> 60) & 0xf];
+            slice <<= 4;
+            for (uint32_t s = sampleIndex; s < sliceEnd; ++s)
+            {
+                const int residual = dequant[(slice >> 61) & 0x7];
+                const int sample = std::clamp(lms[c].Predict() + residual, -32768, 32767);
+                frameSamples[static_cast<size_t>(s) * channels + c] = static_cast<int16_t>(sample);
+                lms[c].Update(sample, residual);
+                slice <<= 3;
+            }
+        }
+    }
+    decodedFrame = index;
+    decodedLength = length;
+    return true;
+}
+
+// 按大端读取 8 字节
+uint64_t QoaDecoder::ReadU64(const size_t offset) const
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) value = (value << 8) | data[offset + i];
+    return value;
+}
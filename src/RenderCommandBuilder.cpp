@@ -0,0 +1,120 @@
+// src/RenderCommandBuilder.cpp
+#include "../include/RenderCommandBuilder.h"
+#include "../include/EntitySystems.h"
+
+namespace
+{
+    // 清空列表，设置剔除视口与资源钩子
+    void BeginList(const RenderInputs& inputs, RenderCommandList& commands)
+    {
+        commands.Begin(inputs.viewport);
+        commands.SetResourceHooks(inputs.resources);
+    }
+
+    // 记录恐龙头顶的冲刺冷却条
+    void RecordCooldownBar(const Dinosaur& dino, const Sword& sword, RenderCommandList& commands)
+    {
+        const float dinoDrawX = dino.position.x;
+        const float dinoDrawY = dino.position.y;
+        const float dinoDrawWidth = dino.GetWidth();
+        const float cdBarMaxWidth = dinoDrawWidth * 0.7f;
+        constexpr float cdBarHeight = 7.0f;
+        constexpr float cdBarOffsetY = 12.0f;
+        const float cooldownProgress = sword.GetCooldownProgress();
+        const float currentCDBarWidth = cdBarMaxWidth * cooldownProgress;
+
+        // 冷却条背景位置
+        const Rectangle cdBarBgRect = {
+            dinoDrawX + (dinoDrawWidth / 2.0f) - (cdBarMaxWidth / 2.0f),
+            dinoDrawY - cdBarHeight - cdBarOffsetY,
+            cdBarMaxWidth,
+            cdBarHeight
+        };
+        // 冷却条背景
+        commands.AddRectangle(RenderLayer::PLAYER_HUD, cdBarBgRect, Fade(DARKGRAY, 0.75f));
+        // 冷却进度条
+        commands.AddRectangle(RenderLayer::PLAYER_HUD,
+                              {cdBarBgRect.x, cdBarBgRect.y, currentCDBarWidth, cdBarHeight}, LIGHTGRAY);
+        // 边框
+        commands.AddRectangleLines(RenderLayer::PLAYER_HUD, cdBarBgRect, 1.0f, BLACK);
+    }
+
+    // 记录世界部分的绘制命令 (不清空列表)
+    void RecordWorld(const RenderSnapshot& frame, const RenderInputs& inputs, RenderCommandList& commands)
+    {
+        if (inputs.background) inputs.background->Draw(frame.background, commands);
+        if (inputs.ground) inputs.ground->Draw(frame.ground, frame.groundY, commands);
+        if (inputs.groundDecals) inputs.groundDecals->Draw(frame.groundDecals, commands);
+        if (frame.dino)
+        {
+            frame.dashTrailParticles.Draw(commands, RenderLayer::PLAYER_TRAIL);
+            frame.dino->Draw(commands, frame.animationTime);
+            if (frame.playerSword && frame.playerSword->IsOnCooldown())
+            {
+                RecordCooldownBar(*frame.dino, *frame.playerSword, commands);
+            }
+        }
+        EntitySystems::Draw(frame.entities, frame.animationTime, RenderLayer::OBSTACLES, commands);
+        if (frame.playerSword && frame.dino)
+        {
+            frame.playerSword->Draw(commands, *frame.dino);
+        }
+        frame.birdDeathParticles.Draw(commands, RenderLayer::PARTICLES);
+    }
+
+    // 记录覆盖部分的绘制命令 (不清空列表)
+    void RecordOverlay(const RenderSnapshot& frame, const RenderInputs& inputs, RenderCommandList& commands)
+    {
+        const Rectangle& screenRect = inputs.viewport;
+        if (inputs.scoreText) commands.AddTextLayout(RenderLayer::HUD, *inputs.scoreText, {20.0f, 20.0f}, DARKGRAY);
+        if (inputs.timeText)
+        {
+            const auto timeX = static_cast<float>(static_cast<int>(screenRect.width) -
+                static_cast<int>(inputs.timeText->size.x) - 20);
+            commands.AddTextLayout(RenderLayer::HUD, *inputs.timeText, {timeX, 20.0f}, DARKGRAY);
+        }
+        if (inputs.performanceText)
+        {
+            commands.AddTextLayout(RenderLayer::HUD, *inputs.performanceText, {20.0f, 56.0f}, GRAY);
+        }
+        if (inputs.jobPerformanceText)
+        {
+            commands.AddTextLayout(RenderLayer::HUD, *inputs.jobPerformanceText, {20.0f, 70.0f}, GRAY);
+        }
+
+        frame.instructionManager.Draw(commands);
+
+        // 菜单界面使用缓存的整屏纹理，遮罩单独绘制
+        if (frame.state == GameState::GAME_OVER)
+        {
+            commands.AddTexture(RenderLayer::UI, inputs.gameOverLayer, inputs.uiSource, screenRect);
+        }
+        else if (frame.state == GameState::PAUSED)
+        {
+            commands.AddRectangle(RenderLayer::OVERLAY, screenRect, Fade(BLACK, 0.8f));
+            commands.AddTexture(RenderLayer::UI, inputs.pauseLayer, inputs.uiSource, screenRect);
+        }
+    }
+}
+
+// 整帧：世界部分与覆盖部分记录到同一个列表
+void RenderCommandBuilder::Build(const RenderSnapshot& frame, const RenderInputs& inputs, RenderCommandList& commands)
+{
+    BeginList(inputs, commands);
+    RecordWorld(frame, inputs, commands);
+    RecordOverlay(frame, inputs, commands);
+}
+
+void RenderCommandBuilder::BuildWorld(const RenderSnapshot& frame, const RenderInputs& inputs,
+                                      RenderCommandList& commands)
+{
+    BeginList(inputs, commands);
+    RecordWorld(frame, inputs, commands);
+}
+
+void RenderCommandBuilder::BuildOverlay(const RenderSnapshot& frame, const RenderInputs& inputs,
+                                        RenderCommandList& commands)
+{
+    BeginList(inputs, commands);
+    RecordOverlay(frame, inputs, commands);
+}
@@ -0,0 +1,266 @@
+// src/RenderCommandList.cpp
+#include "../include/RenderCommandList.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+namespace
+{
+    constexpr TextureHandle SHAPES_BATCH = -1; // 形状命令共用的批次 (raylib 的白色形状纹理)
+    constexpr TextureHandle FONT_BATCH = -2; // 文字命令共用的批次 (默认字体纹理)
+
+    // 命令实际使用的 GPU 纹理，用于统计批次中断
+    TextureHandle BatchTexture(const RenderCommand& command)
+    {
+        switch (command.type)
+        {
+        case RenderCommandType::TEXTURE:
+        case RenderCommandType::TEXTURE_BATCH:
+            return command.texture;
+        case RenderCommandType::TEXT:
+            return FONT_BATCH;
+        default:
+            return SHAPES_BATCH;
+        }
+    }
+}
+
+// 从纹理库读取纹理尺寸
+Vector2 RenderResourceHooks::DefaultTextureSize(const TextureHandle texture)
+{
+    const Texture2D& tex = TextureLibrary::Get(texture);
+    return {static_cast<float>(tex.width), static_cast<float>(tex.height)};
+}
+
+RenderCommandList::RenderCommandList()
+    : pendingBatch{}, openBatch(-1), viewport{0, 0, 0, 0}, culledCount(0)
+{
+}
+
+// 清空命令并设置本帧用于剔除的视口
+void RenderCommandList::Begin(const Rectangle newViewport)
+{
+    commands.clear();
+    textBuffer.clear();
+    batchInstances.clear();
+    pendingBatch = RenderCommand{};
+    openBatch = -1;
+    viewport = newViewport;
+    culledCount = 0;
+}
+
+// 创建一条填好公共字段的命令
+RenderCommand RenderCommandList::MakeCommand(const RenderLayer layer, const RenderCommandType type,
+                                             const Rectangle dest, const Color tint)
+{
+    RenderCommand command{};
+    command.layer = layer;
+    command.type = type;
+    command.texture = INVALID_TEXTURE;
+    command.dest = dest;
+    command.tint = tint;
+    return command;
+}
+
+// 判断目标矩形是否完全在视口外
+// 有旋转时用以旋转点为圆心、能覆盖整个矩形的圆做保守判断
+bool RenderCommandList::IsOutsideViewport(const Rectangle dest, const Vector2 origin, const float rotation) const
+{
+    Rectangle bounds = {dest.x - origin.x, dest.y - origin.y, dest.width, dest.height};
+    if (rotation != 0.0f)
+    {
+        const float radius = std::hypot(origin.x, origin.y) + std::hypot(dest.width, dest.height);
+        bounds = {dest.x - radius, dest.y - radius, radius * 2.0f, radius * 2.0f};
+    }
+    return bounds.x + bounds.width < viewport.x || bounds.x > viewport.x + viewport.width ||
+        bounds.y + bounds.height < viewport.y || bounds.y > viewport.y + viewport.height;
+}
+
+// 添加纹理命令
+void RenderCommandList::AddTexture(const RenderLayer layer, const TextureHandle texture, const Rectangle source,
+                                   const Rectangle dest, const Vector2 origin, const float rotation, const Color tint)
+{
+    if (texture == INVALID_TEXTURE) return;
+    if (IsOutsideViewport(dest, origin, rotation))
+    {
+        ++culledCount;
+        return;
+    }
+    RenderCommand command = MakeCommand(layer, RenderCommandType::TEXTURE, dest, tint);
+    command.texture = texture;
+    command.source = source;
+    command.origin = origin;
+    command.rotation = rotation;
+    commands.push_back(command);
+}
+
+// 以左上角位置添加整张纹理
+void RenderCommandList::AddTexture(const RenderLayer layer, const TextureHandle texture, const Vector2 position,
+                                   const Color tint)
+{
+    const auto [width, height] = GetTextureSize(texture);
+    AddTexture(layer, texture, {0.0f, 0.0f, width, height}, {position.x, position.y, width, height},
+               {0.0f, 0.0f}, 0.0f, tint);
+}
+
+// 添加实心矩形命令
+void RenderCommandList::AddRectangle(const RenderLayer layer, const Rectangle rect, const Color color,
+                                     const Vector2 origin, const float rotation)
+{
+    if (IsOutsideViewport(rect, origin, rotation))
+    {
+        ++culledCount;
+        return;
+    }
+    RenderCommand command = MakeCommand(layer, RenderCommandType::RECTANGLE, rect, color);
+    command.origin = origin;
+    command.rotation = rotation;
+    commands.push_back(command);
+}
+
+// 添加矩形边框命令
+void RenderCommandList::AddRectangleLines(const RenderLayer layer, const Rectangle rect, const float lineThickness,
+                                          const Color color)
+{
+    if (IsOutsideViewport(rect, {0, 0}, 0.0f))
+    {
+        ++culledCount;
+        return;
+    }
+    RenderCommand command = MakeCommand(layer, RenderCommandType::RECTANGLE_LINES, rect, color);
+    command.lineThickness = lineThickness;
+    commands.push_back(command);
+}
+
+// 添加文字命令
+void RenderCommandList::AddText(const RenderLayer layer, const char* text, const int x, const int y,
+                                const int fontSize, const Color color)
+{
+    RenderCommand command = MakeCommand(layer, RenderCommandType::TEXT,
+                                        {static_cast<float>(x), static_cast<float>(y), 0.0f,
+                                         static_cast<float>(fontSize)}, color);
+    command.fontSize = fontSize;
+    command.textOffset = static_cast<int>(textBuffer.size());
+    textBuffer.insert(textBuffer.end(), text, text + std::strlen(text) + 1);
+    commands.push_back(command);
+}
+
+// 把排好版的文字按字形添加为纹理命令
+void RenderCommandList::AddTextLayout(const RenderLayer layer, const TextLayout& layout, const Vector2 position,
+                                      const Color color)
+{
+    for (const auto& [source, dest] : layout.glyphs)
+    {
+        AddTexture(layer, layout.fontTexture, source,
+                   {position.x + dest.x, position.y + dest.y, dest.width, dest.height}, {0, 0}, 0.0f, color);
+    }
+}
+
+// 开始一个纹理批次 (实例全部被剔除时不产生命令)
+void RenderCommandList::BeginTextureBatch(const RenderLayer layer, const uint8_t depth, const TextureHandle texture,
+                                          const Rectangle source, const Color tint)
+{
+    pendingBatch = MakeCommand(layer, RenderCommandType::TEXTURE_BATCH, {0, 0, 0, 0}, tint);
+    pendingBatch.depth = depth;
+    pendingBatch.texture = texture;
+    pendingBatch.source = source;
+    pendingBatch.batchOffset = static_cast<int>(batchInstances.size());
+    openBatch = -1;
+}
+
+// 向当前批次添加一个实例
+void RenderCommandList::AddBatchInstance(const Rectangle dest)
+{
+    if (pendingBatch.type != RenderCommandType::TEXTURE_BATCH || pendingBatch.texture == INVALID_TEXTURE) return;
+    if (IsOutsideViewport(dest, {0, 0}, 0.0f))
+    {
+        ++culledCount;
+        return;
+    }
+    if (openBatch < 0)
+    {
+        openBatch = static_cast<int>(commands.size());
+        commands.push_back(pendingBatch);
+    }
+    batchInstances.push_back(dest);
+    ++commands[openBatch].batchCount;
+}
+
+// 按层、深度、类型、纹理稳定排序
+void RenderCommandList::Sort()
+{
+    std::ranges::stable_sort(commands, {}, [](const RenderCommand& command)
+    {
+        return std::tuple(command.layer, command.depth, command.type, command.texture);
+    });
+    openBatch = -1; // 排序后下标失效，之后的实例不能再加入旧批次
+    pendingBatch = RenderCommand{};
+}
+
+// 追加另一个列表的命令，文字和批次实例的下标按当前缓冲长度平移
+void RenderCommandList::Append(const RenderCommandList& other)
+{
+    const auto textBase = static_cast<int>(textBuffer.size());
+    const auto batchBase = static_cast<int>(batchInstances.size());
+    commands.reserve(commands.size() + other.commands.size());
+    for (RenderCommand command : other.commands)
+    {
+        if (command.type == RenderCommandType::TEXT) command.textOffset += textBase;
+        if (command.type == RenderCommandType::TEXTURE_BATCH) command.batchOffset += batchBase;
+        commands.push_back(command);
+    }
+    textBuffer.insert(textBuffer.end(), other.textBuffer.begin(), other.textBuffer.end());
+    batchInstances.insert(batchInstances.end(), other.batchInstances.begin(), other.batchInstances.end());
+    culledCount += other.culledCount;
+    openBatch = -1; // 追加的命令之后不能再向之前的批次添加实例
+    pendingBatch = RenderCommand{};
+}
+
+// 按当前顺序提交所有命令
+void RenderCommandList::Submit() const
+{
+    for (const RenderCommand& command : commands)
+    {
+        switch (command.type)
+        {
+        case RenderCommandType::TEXTURE:
+            DrawTexturePro(TextureLibrary::Get(command.texture), command.source, command.dest, command.origin,
+                           command.rotation, command.tint);
+            break;
+        case RenderCommandType::RECTANGLE:
+            DrawRectanglePro(command.dest, command.origin, command.rotation, command.tint);
+            break;
+        case RenderCommandType::RECTANGLE_LINES:
+            DrawRectangleLinesEx(command.dest, command.lineThickness, command.tint);
+            break;
+        case RenderCommandType::TEXT:
+            DrawText(GetText(command), static_cast<int>(command.dest.x), static_cast<int>(command.dest.y),
+                     command.fontSize, command.tint);
+            break;
+        case RenderCommandType::TEXTURE_BATCH:
+            {
+                const Texture2D& texture = TextureLibrary::Get(command.texture);
+                const Rectangle* instances = GetBatchInstances(command);
+                for (int i = 0; i < command.batchCount; ++i)
+                {
+                    DrawTexturePro(texture, command.source, instances[i], {0.0f, 0.0f}, 0.0f, command.tint);
+                }
+            }
+            break;
+        }
+    }
+}
+
+// 统计命令数量、剔除数量与纹理切换次数
+RenderListStats RenderCommandList::GetStats() const
+{
+    RenderListStats stats;
+    stats.commandCount = static_cast<int>(commands.size());
+    stats.culledCount = culledCount;
+    for (size_t i = 1; i < commands.size(); ++i)
+    {
+        if (BatchTexture(commands[i]) != BatchTexture(commands[i - 1])) ++stats.textureSwitches;
+    }
+    return stats;
+}
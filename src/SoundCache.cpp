@@ -0,0 +1,137 @@
+// src/SoundCache.cpp
+#include "../include/SoundCache.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t CACHE_MAGIC = 0x43584653; // "SFXC"
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    // 缓存文件头，后面紧跟 frameCount * channels 个 float 采样
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t sampleRate;
+        uint32_t channels;
+        uint32_t frameCount;
+        uint32_t reserved;
+    };
+}
+
+AudioDeviceFormat SoundCache::deviceFormat;
+std::atomic<int> SoundCache::hitCount(0);
+std::atomic<int> SoundCache::missCount(0);
+
+// 加载音效
+Sound SoundCache::Load(const char* path)
+{
+    GetDeviceFormat();
+    Wave wave = LoadWave(path);
+    if (wave.frameCount == 0) return Sound{};
+
+    // 格式已经与设备一致，raylib 加载时只是复制
+    const Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+    return sound;
+}
+
+// 加载设备格式的波形：哈希源文件，命中缓存时直接使用设备格式的采样，否则解码、转换并写入缓存
+Wave SoundCache::LoadWave(const char* path)
+{
+    int sourceSize = 0;
+    unsigned char* sourceData = LoadFileData(path, &sourceSize);
+    if (sourceData == nullptr) return Wave{};
+    const uint64_t sourceHash = HashData(sourceData, sourceSize);
+    const AudioDeviceFormat format = deviceFormat;
+
+    char cachePath[256];
+    std::snprintf(cachePath, sizeof(cachePath), "%s/%016llx_%u_%u.pcm", CACHE_DIRECTORY,
+                  static_cast<unsigned long long>(sourceHash), format.sampleRate, format.channels);
+
+    Wave wave = ReadCache(cachePath, sourceHash, format);
+    if (wave.frameCount > 0)
+    {
+        ++hitCount;
+    }
+    else
+    {
+        ++missCount;
+        wave = LoadWaveFromMemory(GetFileExtension(path), sourceData, sourceSize);
+        if (wave.frameCount > 0 && format.sampleRate > 0)
+        {
+            WaveFormat(&wave, static_cast<int>(format.sampleRate), 32, static_cast<int>(format.channels));
+            WriteCache(cachePath, sourceHash, wave);
+        }
+    }
+    UnloadFileData(sourceData);
+    return wave;
+}
+
+// 用一个只有一帧的音效探测设备格式：raylib 总是把音效转换成设备格式
+AudioDeviceFormat SoundCache::GetDeviceFormat()
+{
+    if (deviceFormat.sampleRate == 0 && IsAudioDeviceReady())
+    {
+        float sample[2] = {0.0f, 0.0f};
+        const Wave probe{1, 44100, 32, 2, sample};
+        const Sound sound = LoadSoundFromWave(probe);
+        deviceFormat = {sound.stream.sampleRate, sound.stream.channels};
+        UnloadSound(sound);
+    }
+    return deviceFormat;
+}
+
+// 64 位 FNV-1a
+uint64_t SoundCache::HashData(const unsigned char* data, const int size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (int i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// 读取缓存文件，不存在或与源文件、设备格式不符时返回空的 Wave
+Wave SoundCache::ReadCache(const char* cachePath, const uint64_t sourceHash, const AudioDeviceFormat format)
+{
+    if (format.sampleRate == 0 || !FileExists(cachePath)) return Wave{};
+    int size = 0;
+    unsigned char* data = LoadFileData(cachePath, &size);
+    if (data == nullptr) return Wave{};
+
+    Wave wave{};
+    CacheHeader header{};
+    if (static_cast<size_t>(size) >= sizeof(header))
+    {
+        std::memcpy(&header, data, sizeof(header));
+        const size_t sampleBytes = static_cast<size_t>(header.frameCount) * header.channels * sizeof(float);
+        if (header.magic == CACHE_MAGIC && header.version == CACHE_VERSION && header.sourceHash == sourceHash &&
+            header.sampleRate == format.sampleRate && header.channels == format.channels && header.frameCount > 0 &&
+            static_cast<size_t>(size) == sizeof(header) + sampleBytes)
+        {
+            // raylib 的 Wave 由 UnloadWave 用 RL_FREE 释放，所以数据也用 MemAlloc 分配
+            wave = {header.frameCount, header.sampleRate, 32, header.channels, MemAlloc(static_cast<unsigned int>(sampleBytes))};
+            std::memcpy(wave.data, data + sizeof(header), sampleBytes);
+        }
+    }
+    UnloadFileData(data);
+    return wave;
+}
+
+// 写入缓存文件，失败时只是下次启动再转换一次
+void SoundCache::WriteCache(const char* cachePath, const uint64_t sourceHash, const Wave& wave)
+{
+    if (!DirectoryExists(CACHE_DIRECTORY) && MakeDirectory(CACHE_DIRECTORY) != 0) return;
+    const CacheHeader header{CACHE_MAGIC, CACHE_VERSION, sourceHash, wave.sampleRate, wave.channels, wave.frameCount, 0};
+    const size_t sampleBytes = static_cast<size_t>(wave.frameCount) * wave.channels * sizeof(float);
+    std::vector<unsigned char> bytes(sizeof(header) + sampleBytes);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), wave.data, sampleBytes);
+    SaveFileData(cachePath, bytes.data(), static_cast<int>(bytes.size()));
+}
@@ -0,0 +1,327 @@
+// src/SpawnGenerator.cpp
+#include "../include/SpawnGenerator.h"
+#include "../include/PassabilityVerifier.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // 图案中的一步
+    struct SpawnPatternStep
+    {
+        SpawnType type; // 实体类型
+        float gapMinSeconds; // 与上一步的最小间隔 (按当前滚动速度换算成距离)
+        float gapMaxSeconds; // 与上一步的最大间隔
+        float heightMin; // 鸟的最小高度系数
+        float heightMax; // 鸟的最大高度系数
+    };
+
+    // 一个障碍物图案
+    struct SpawnPattern
+    {
+        float minDifficulty; // 解锁该图案所需的难度
+        float baseWeight; // 难度为0时的权重
+        float hardWeight; // 难度为1时的权重
+        int stepCount; // 步数
+        SpawnPatternStep steps[4]; // 各步内容 (第一步的间隔不使用，由图案之间的间隔决定)
+    };
+
+    constexpr SpawnPattern PATTERNS[] = {
+        // 单个小仙人掌
+        {0.0f, 3.0f, 1.0f, 1, {{SpawnType::SMALL_CACTUS, 0, 0, 0, 0}}},
+        // 单个大仙人掌
+        {0.0f, 1.5f, 1.0f, 1, {{SpawnType::BIG_CACTUS, 0, 0, 0, 0}}},
+        // 高空的鸟 (通常可以直接无视)
+        {0.0f, 2.0f, 0.5f, 1, {{SpawnType::BIRD, 0, 0, 0.0f, 0.45f}}},
+        // 中间高度的鸟 (需要潜行或跳跃)
+        {0.0f, 2.0f, 1.5f, 1, {{SpawnType::BIRD, 0, 0, 0.55f, 0.8f}}},
+        // 贴地的鸟 (需要跳跃)
+        {0.1f, 1.0f, 1.5f, 1, {{SpawnType::BIRD, 0, 0, 0.9f, 1.0f}}},
+        // 连续两个小仙人掌，一跳越过
+        {0.2f, 0.5f, 1.5f, 2, {
+            {SpawnType::SMALL_CACTUS, 0, 0, 0, 0},
+            {SpawnType::SMALL_CACTUS, 0.10f, 0.16f, 0, 0}
+        }},
+        // 仙人掌后紧跟一只鸟
+        {0.35f, 0.5f, 1.5f, 2, {
+            {SpawnType::SMALL_CACTUS, 0, 0, 0, 0},
+            {SpawnType::BIRD, 0.55f, 0.8f, 0.3f, 0.75f}
+        }},
+        // 鸟群
+        {0.6f, 0.2f, 1.2f, 3, {
+            {SpawnType::BIRD, 0, 0, 0.2f, 0.6f},
+            {SpawnType::BIRD, 0.25f, 0.4f, 0.5f, 0.8f},
+            {SpawnType::BIRD, 0.25f, 0.4f, 0.0f, 0.5f}
+        }},
+        // 大小仙人掌组成的墙
+        {0.75f, 0.2f, 1.0f, 2, {
+            {SpawnType::BIG_CACTUS, 0, 0, 0, 0},
+            {SpawnType::SMALL_CACTUS, 0.08f, 0.12f, 0, 0}
+        }},
+    };
+
+    float RandomRange(std::mt19937& rng, const float min, const float max)
+    {
+        if (min >= max) return min;
+        std::uniform_real_distribution<float> distribution(min, max);
+        return distribution(rng);
+    }
+
+    // 按难度为鸟选择飞行曲线：难度越高，起伏和俯冲越常见；俯冲只给较高的鸟，落点不会低于地面
+    FlightPath RandomFlightPath(std::mt19937& rng, const float difficulty, const float heightFactor)
+    {
+        FlightPath path;
+        path.speedFactor = RandomRange(rng, 1.1f, 1.7f);
+        const float swoopChance = 0.1f + 0.3f * difficulty;
+        const float diveChance = difficulty >= 0.5f && heightFactor < 0.6f ? 0.3f * difficulty : 0.0f;
+        const float roll = RandomRange(rng, 0.0f, 1.0f);
+        if (roll < diveChance)
+        {
+            path.profile = FlightProfile::DIVE;
+            path.amplitude = RandomRange(rng, 0.3f, 1.0f - heightFactor);
+            path.length = RandomRange(rng, 200.0f, 400.0f);
+            path.start = RandomRange(rng, 250.0f, 600.0f);
+        }
+        else if (roll < diveChance + swoopChance)
+        {
+            path.profile = FlightProfile::SWOOP;
+            path.amplitude = RandomRange(rng, 0.08f, 0.18f);
+            path.length = RandomRange(rng, 350.0f, 700.0f);
+            path.start = RandomRange(rng, 0.0f, path.length);
+        }
+        return path;
+    }
+}
+
+// 按高度系数计算鸟的顶部Y坐标
+float SpawnGeometry::BirdTopY(const float heightFactor) const
+{
+    const float upperLimit = screenHeight * 0.3f;
+    const float lowerLimit = groundY - birdSize.y;
+    float spawnY;
+    if (upperLimit >= lowerLimit)
+    {
+        spawnY = std::min(upperLimit, lowerLimit);
+    }
+    else
+    {
+        spawnY = upperLimit + (lowerLimit - upperLimit) * heightFactor;
+    }
+    spawnY = std::max(spawnY, 0.0f);
+    return std::min(spawnY, groundY - birdSize.y);
+}
+
+// 获取仙人掌变体的尺寸
+Vector2 SpawnGeometry::CactusSize(const SpawnType type, const int variant) const
+{
+    // 与 Game::SpawnObstacleOrBird 一致：缺少大仙人掌时退回小仙人掌
+    const bool useSmall = (type == SpawnType::SMALL_CACTUS && !smallCactusSizes.empty()) || bigCactusSizes.empty();
+    const std::vector<Vector2>& sizes = useSmall ? smallCactusSizes : bigCactusSizes;
+    if (sizes.empty()) return {0, 0};
+    return sizes[variant % sizes.size()];
+}
+
+SpawnGenerator::SpawnGenerator()
+    : running(false), wakeCounter(0), seed(0)
+{
+}
+
+SpawnGenerator::~SpawnGenerator()
+{
+    Stop();
+}
+
+// 计算世界滚动到指定距离时的基础滚动速度
+// 速度随时间线性增长，所以 v^2 = v0^2 + 2 * a * d
+float SpawnGenerator::ScrollSpeedAtDistance(const SpawnGeneratorConfig& config, const float distance)
+{
+    const float v0 = config.baseScrollSpeed;
+    return std::sqrt(v0 * v0 + 2.0f * config.scrollSpeedIncreaseRate * std::max(distance, 0.0f));
+}
+
+// 根据滚动速度计算难度
+float SpawnGenerator::DifficultyForSpeed(const SpawnGeneratorConfig& config, const float scrollSpeed)
+{
+    const float range = config.maxDifficultyScrollSpeed - config.baseScrollSpeed;
+    if (range <= 0.0f) return 1.0f;
+    return std::clamp((scrollSpeed - config.baseScrollSpeed) / range, 0.0f, 1.0f);
+}
+
+// 根据种子、分块序号和起始距离生成分块
+SpawnChunk SpawnGenerator::BuildChunk(const SpawnGeneratorConfig& config, const unsigned int seed,
+                                      const int chunkIndex, const float startDistance, const int attempt)
+{
+    std::seed_seq seedSequence{seed, static_cast<unsigned int>(chunkIndex), static_cast<unsigned int>(attempt)};
+    std::mt19937 rng(seedSequence);
+
+    SpawnChunk chunk;
+    chunk.index = chunkIndex;
+    chunk.startDistance = startDistance;
+    const float scrollSpeed = ScrollSpeedAtDistance(config, startDistance);
+    chunk.difficulty = DifficultyForSpeed(config, scrollSpeed);
+
+    // 难度越高，图案之间的间隔越短
+    const float minPatternGap = 0.9f + (0.4f - 0.9f) * chunk.difficulty;
+    const float maxPatternGap = 1.8f + (1.0f - 1.8f) * chunk.difficulty;
+
+    // 已解锁图案的权重表
+    float weights[std::size(PATTERNS)];
+    float totalWeight = 0.0f;
+    for (size_t i = 0; i < std::size(PATTERNS); ++i)
+    {
+        const SpawnPattern& pattern = PATTERNS[i];
+        weights[i] = chunk.difficulty >= pattern.minDifficulty
+                         ? pattern.baseWeight + (pattern.hardWeight - pattern.baseWeight) * chunk.difficulty
+                         : 0.0f;
+        totalWeight += weights[i];
+    }
+
+    for (int p = 0; p < config.patternsPerChunk; ++p)
+    {
+        // 按权重选择图案
+        float roll = RandomRange(rng, 0.0f, totalWeight);
+        size_t patternIndex = 0;
+        while (patternIndex + 1 < std::size(PATTERNS) && roll >= weights[patternIndex])
+        {
+            roll -= weights[patternIndex];
+            ++patternIndex;
+        }
+        if (weights[patternIndex] <= 0.0f) patternIndex = 0; // 浮点误差落到未解锁图案时退回最简单的图案
+        const SpawnPattern& pattern = PATTERNS[patternIndex];
+        if (chunk.eventCount + pattern.stepCount > MAX_CHUNK_EVENTS) break;
+
+        for (int s = 0; s < pattern.stepCount; ++s)
+        {
+            const SpawnPatternStep& step = pattern.steps[s];
+            SpawnEvent& event = chunk.events[chunk.eventCount++];
+            event.type = step.type;
+            const float gapSeconds = s == 0
+                                         ? RandomRange(rng, minPatternGap, maxPatternGap)
+                                         : RandomRange(rng, step.gapMinSeconds, step.gapMaxSeconds);
+            event.gapBefore = gapSeconds * scrollSpeed;
+            event.variant = static_cast<int>(rng() % 16);
+            event.heightFactor = RandomRange(rng, step.heightMin, step.heightMax);
+            if (event.type == SpawnType::BIRD) event.flight = RandomFlightPath(rng, chunk.difficulty, event.heightFactor);
+            chunk.length += event.gapBefore;
+        }
+    }
+    return chunk;
+}
+
+// 生成紧接 previousChunk 的分块，并保证它能通过验证
+SpawnChunk SpawnGenerator::BuildVerifiedChunk(const SpawnGeneratorConfig& config, const unsigned int seed,
+                                              const SpawnChunk& previousChunk, const PassabilityVerifier* verifier,
+                                              ChunkVerification* verification)
+{
+    ChunkVerification ignored;
+    if (!verification) verification = &ignored;
+    const int chunkIndex = previousChunk.index + 1;
+    const float startDistance = previousChunk.startDistance + previousChunk.length;
+    SpawnChunk chunk = BuildChunk(config, seed, chunkIndex, startDistance);
+    *verification = ChunkVerification::UNVERIFIED;
+    if (!verifier) return chunk;
+
+    const SpawnChunk* context = previousChunk.index >= 0 ? &previousChunk : nullptr;
+    *verification = ChunkVerification::PASSED;
+    for (int attempt = 1; attempt <= MAX_REGENERATE_ATTEMPTS; ++attempt)
+    {
+        if (verifier->IsChunkPassable(config, chunk, context)) return chunk;
+        chunk = BuildChunk(config, seed, chunkIndex, startDistance, attempt);
+        *verification = ChunkVerification::REGENERATED;
+    }
+    if (verifier->IsChunkPassable(config, chunk, context)) return chunk;
+    // 换种子仍然不行，逐步拉大所有间隔直到可以通过
+    *verification = ChunkVerification::REPAIRED;
+    for (int repair = 0; repair < MAX_REPAIR_ATTEMPTS; ++repair)
+    {
+        chunk.length = 0.0f;
+        for (int i = 0; i < chunk.eventCount; ++i)
+        {
+            chunk.events[i].gapBefore *= 1.25f;
+            chunk.length += chunk.events[i].gapBefore;
+        }
+        if (verifier->IsChunkPassable(config, chunk, context)) return chunk;
+    }
+    // 修复也失败时不能把无法通过的分块交给玩家，换成保底分块
+    *verification = ChunkVerification::FALLBACK;
+    return BuildFallbackChunk(config, chunkIndex, startDistance);
+}
+
+// 保底分块：最简单的图案配最宽的间隔
+SpawnChunk SpawnGenerator::BuildFallbackChunk(const SpawnGeneratorConfig& config, const int chunkIndex,
+                                              const float startDistance)
+{
+    SpawnChunk chunk;
+    chunk.index = chunkIndex;
+    chunk.startDistance = startDistance;
+    const float scrollSpeed = ScrollSpeedAtDistance(config, startDistance);
+    chunk.difficulty = DifficultyForSpeed(config, scrollSpeed);
+    SpawnEvent& event = chunk.events[chunk.eventCount++];
+    event.type = SpawnType::SMALL_CACTUS;
+    event.gapBefore = FALLBACK_GAP_SECONDS * scrollSpeed;
+    chunk.length = event.gapBefore;
+    return chunk;
+}
+
+// 从 previousChunk 之后的分块开始 (重新) 启动后台生成
+void SpawnGenerator::Restart(const SpawnGeneratorConfig& newConfig, const unsigned int newSeed,
+                             const SpawnChunk& previousChunk)
+{
+    Stop();
+    readyChunks.Clear();
+    config = newConfig;
+    seed = newSeed;
+    lastBuiltChunk = previousChunk;
+    running.store(true);
+    worker = std::thread(&SpawnGenerator::WorkerLoop, this);
+}
+
+// 设置即时通关验证器
+void SpawnGenerator::SetVerifier(std::shared_ptr<const PassabilityVerifier> newVerifier)
+{
+    verifier = std::move(newVerifier);
+}
+
+// 停止后台线程
+void SpawnGenerator::Stop()
+{
+    if (!worker.joinable()) return;
+    running.store(false);
+    wakeCounter.fetch_add(1);
+    wakeCounter.notify_one();
+    worker.join();
+}
+
+// 取出下一个已生成的分块
+bool SpawnGenerator::TryPopChunk(SpawnChunk& chunk)
+{
+    if (!readyChunks.TryPop(chunk)) return false;
+    // 队列腾出了空位，唤醒后台线程继续生成
+    wakeCounter.fetch_add(1);
+    wakeCounter.notify_one();
+    return true;
+}
+
+// 后台线程主循环：队列未满时持续生成，满了就阻塞等待消费
+void SpawnGenerator::WorkerLoop()
+{
+    while (running.load())
+    {
+        // 先记下唤醒计数再检查队列，避免错过检查之后发生的唤醒
+        const unsigned int observedWake = wakeCounter.load();
+        if (readyChunks.IsFull())
+        {
+            wakeCounter.wait(observedWake);
+            continue;
+        }
+        ChunkVerification verification = ChunkVerification::UNVERIFIED;
+        lastBuiltChunk = BuildVerifiedChunk(config, seed, lastBuiltChunk, verifier.get(), &verification);
+        if (verification == ChunkVerification::FALLBACK)
+        {
+            TraceLog(LOG_WARNING, "SPAWN: Chunk %d of seed %u failed verification after repairs, using fallback chunk",
+                     lastBuiltChunk.index, seed);
+        }
+        readyChunks.TryPush(lastBuiltChunk);
+    }
+}
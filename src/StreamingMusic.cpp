@@ -0,0 +1,136 @@
+// src/StreamingMusic.cpp
+#include "../include/StreamingMusic.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+StreamingMusic::StreamingMusic() : stream{}, loaded(false), playing(false)
+{
+}
+
+// 加载 QOA 文件：只保存压缩数据，音频流的缓冲只有两块 STREAM_CHUNK_FRAMES
+bool StreamingMusic::Load(const char* path, const float volume)
+{
+    Unload();
+    int size = 0;
+    unsigned char* fileData = LoadFileData(path, &size);
+    if (fileData == nullptr) return false;
+    std::vector<uint8_t> bytes(fileData, fileData + size);
+    UnloadFileData(fileData);
+    if (!decoder.Open(std::move(bytes)))
+    {
+        TraceLog(LOG_WARNING, "MUSIC: [%s] Not a valid QOA file", path);
+        decoder.Close();
+        return false;
+    }
+
+    loopPoints = ReadLoopPoints(path, decoder.GetTotalFrames());
+    chunk.resize(static_cast<size_t>(STREAM_CHUNK_FRAMES) * decoder.GetChannels());
+    SetAudioStreamBufferSizeDefault(static_cast<int>(STREAM_CHUNK_FRAMES));
+    stream = LoadAudioStream(decoder.GetSampleRate(), 16, decoder.GetChannels());
+    SetAudioStreamBufferSizeDefault(0); // 恢复默认，不影响其它音频流
+    if (!IsAudioStreamValid(stream))
+    {
+        decoder.Close();
+        return false;
+    }
+    SetAudioStreamVolume(stream, volume);
+    loaded = true;
+    return true;
+}
+
+// 卸载
+void StreamingMusic::Unload()
+{
+    if (loaded)
+    {
+        StopAudioStream(stream);
+        UnloadAudioStream(stream);
+    }
+    stream = AudioStream{};
+    decoder.Close();
+    chunk.clear();
+    loaded = false;
+    playing = false;
+}
+
+// 从开头播放
+void StreamingMusic::Play()
+{
+    if (!loaded || playing) return;
+    decoder.Seek(0);
+    playing = true;
+    Update(); // 先填满两块缓冲，开始播放时不会先放出静音
+    PlayAudioStream(stream);
+}
+
+// 暂停
+void StreamingMusic::Pause()
+{
+    if (loaded && playing) PauseAudioStream(stream);
+}
+
+// 恢复
+void StreamingMusic::Resume()
+{
+    if (loaded && playing) ResumeAudioStream(stream);
+}
+
+// 停止并回到开头
+void StreamingMusic::Stop()
+{
+    if (!loaded || !playing) return;
+    StopAudioStream(stream);
+    decoder.Seek(0);
+    playing = false;
+}
+
+// 填充已经播放完的缓冲 (最多两块)
+void StreamingMusic::Update()
+{
+    if (!loaded || !playing) return;
+    while (IsAudioStreamProcessed(stream))
+    {
+        FillChunk();
+        UpdateAudioStream(stream, chunk.data(), static_cast<int>(STREAM_CHUNK_FRAMES));
+    }
+}
+
+// 解码一块采样，到循环结束处跳回循环开始继续解码，同一块内完成拼接
+void StreamingMusic::FillChunk()
+{
+    const uint32_t channels = decoder.GetChannels();
+    uint32_t filled = 0;
+    while (filled < STREAM_CHUNK_FRAMES)
+    {
+        if (decoder.GetPosition() >= loopPoints.end) decoder.Seek(loopPoints.start);
+        const uint32_t request = std::min(STREAM_CHUNK_FRAMES - filled, loopPoints.end - decoder.GetPosition());
+        const uint32_t count = decoder.Read(chunk.data() + static_cast<size_t>(filled) * channels, request);
+        if (count == 0) break; // 数据损坏：剩余部分填静音
+        filled += count;
+    }
+    std::fill(chunk.begin() + static_cast<std::ptrdiff_t>(filled) * channels, chunk.end(), int16_t{0});
+}
+
+// 读取 path.loop 中的循环区间
+MusicLoopPoints StreamingMusic::ReadLoopPoints(const char* path, const uint32_t totalFrames)
+{
+    MusicLoopPoints points{0, totalFrames};
+    const std::string metadataPath = std::string(path) + ".loop";
+    if (!FileExists(metadataPath.c_str())) return points;
+
+    char* text = LoadFileText(metadataPath.c_str());
+    if (text == nullptr) return points;
+    unsigned int start = 0;
+    unsigned int end = 0;
+    if (std::sscanf(text, "%u %u", &start, &end) == 2 && start < end && end <= totalFrames)
+    {
+        points = {start, end};
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "MUSIC: [%s] Invalid loop points, looping the whole track", metadataPath.c_str());
+    }
+    UnloadFileText(text);
+    return points;
+}
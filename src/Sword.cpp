@@ -1,10 +1,9 @@
 // src/Sword.cpp
 #include "../include/Sword.h"
 
-Sword::Sword(const Texture2D& tex, const Sound& sound, Dinosaur* ownerDino)
+Sword::Sword(const TextureHandle tex, const SoundHandle sound)
     : texture(tex),
       swingSound(sound),
-      owner(ownerDino),
       cooldownTimer(0.0f),
       attackCooldown(1.0f),
       isAttackingState(false),
@@ -27,14 +26,14 @@ bool Sword::IsAttacking() const
 }
 
 // 获取剑在恐龙身上的旋转中心点
-Vector2 Sword::GetAttachmentPoint() const
+Vector2 Sword::GetAttachmentPoint(const Dinosaur& owner)
 {
-    if (owner->IsFacingRight()) // 恐龙朝右
+    if (owner.IsFacingRight()) // 恐龙朝右
     {
-        return {owner->position.x + owner->GetWidth() * 0.75f, owner->position.y + owner->GetHeight() * 0.40f};
+        return {owner.position.x + owner.GetWidth() * 0.75f, owner.position.y + owner.GetHeight() * 0.40f};
     }
     // 恐龙朝左
-    return {owner->position.x + owner->GetWidth() * 0.25f, owner->position.y + owner->GetHeight() * 0.40f};
+    return {owner.position.x + owner.GetWidth() * 0.25f, owner.position.y + owner.GetHeight() * 0.40f};
 }
 
 // 执行攻击
@@ -45,12 +44,12 @@ void Sword::Attack()
         isAttackingState = true;
         attackTimer = 0.0f; // 重置攻击动画计时器
         cooldownTimer = attackCooldown; // 开始攻击冷却
-        PlaySound(swingSound);
+        AudioSystem::Play(swingSound);
     }
 }
 
 // 更新剑的状态，每帧调用
-void Sword::Update(const float deltaTime)
+void Sword::Update(const float deltaTime, const Dinosaur& owner)
 {
     // 更新冷却计时器
     if (cooldownTimer > 0.0f)
@@ -75,7 +74,7 @@ void Sword::Update(const float deltaTime)
     const float currentRelativeAngle = Lerp(swingStartAngleWorld, swingEndAngleWorld, attackProgress);
     float finalDrawRotation; // 最终用于绘制的旋转角度
 
-    if (owner->IsFacingRight())
+    if (owner.IsFacingRight())
     {
         finalDrawRotation = currentRelativeAngle - textureInitialAngle;
     }
@@ -92,20 +91,21 @@ void Sword::Update(const float deltaTime)
 }
 
 // 绘制剑
-void Sword::Draw() const
+void Sword::Draw(RenderCommandList& commands, const Dinosaur& owner) const
 {
     if (!isAttackingState) return;
 
+    const auto [swordWidth, swordHeight] = commands.GetTextureSize(texture);
     // 源矩形 
-    Rectangle sourceRec = {0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height)};
-    const auto [x, y] = GetAttachmentPoint(); // 剑的附着点
+    Rectangle sourceRec = {0.0f, 0.0f, swordWidth, swordHeight};
+    const auto [x, y] = GetAttachmentPoint(owner); // 剑的附着点
 
     Vector2 drawOrigin = {pivotInTexture.x * drawScale, pivotInTexture.y * drawScale};
 
-    if (!owner->IsFacingRight())
+    if (!owner.IsFacingRight())
     {
         sourceRec.width *= -1; // 翻转
-        drawOrigin.x = (texture.width - pivotInTexture.x) * drawScale;
+        drawOrigin.x = (swordWidth - pivotInTexture.x) * drawScale;
     }
 
     const Rectangle destRec = {
@@ -115,26 +115,27 @@ void Sword::Draw() const
         sourceRec.height * drawScale
     };
 
-    DrawTexturePro(texture, sourceRec, destRec, drawOrigin, currentVisualRotation, WHITE);
+    commands.AddTexture(RenderLayer::WEAPON, texture, sourceRec, destRec, drawOrigin, currentVisualRotation, WHITE);
 }
 
 // 获取剑的轴对齐包围盒AABB
-Rectangle Sword::GetSwordAABB() const
+Rectangle Sword::GetSwordAABB(const Dinosaur& owner) const
 {
-    const auto [x, y] = GetAttachmentPoint();
-    const float baseSwordWidth = texture.width * drawScale;
-    const float baseSwordHeight = texture.height * drawScale;
+    const Texture2D& swordTex = TextureLibrary::Get(texture);
+    const auto [x, y] = GetAttachmentPoint(owner);
+    const float baseSwordWidth = swordTex.width * drawScale;
+    const float baseSwordHeight = swordTex.height * drawScale;
     float topLeftX; // AABB的左上角X
     const float topLeftY = y - (pivotInTexture.y * drawScale); // AABB的左上角Y (基于轴心点)
 
     // 根据朝向计算AABB的左上角X
-    if (owner->IsFacingRight())
+    if (owner.IsFacingRight())
     {
         topLeftX = x - (pivotInTexture.x * drawScale);
     }
     else // 朝左时，轴心点相对于纹理右侧
     {
-        topLeftX = x - ((texture.width - pivotInTexture.x) * drawScale);
+        topLeftX = x - ((swordTex.width - pivotInTexture.x) * drawScale);
     }
 
     // 未旋转时的基础AABB
@@ -161,33 +162,32 @@ Rectangle Sword::GetSwordAABB() const
     return collisionRect;
 }
 
-// 检测剑与鸟群的碰撞
-void Sword::CheckCollisionsWithBirds(std::vector<Bird>& birds, int& gameScore,
+// 检测剑与可被击杀的实体的碰撞
+void Sword::CheckCollisionsWithBirds(const Dinosaur& owner, EntityWorld& entities, int& gameScore,
                                      ParticleSystem& effectParticles,
                                      const ParticleProperties& effectProps,
-                                     const float worldScrollSpeed, const Sound& birdScreamSound) const
+                                     const float worldScrollSpeed, const SoundHandle birdScreamSound) const
 {
     if (!isAttackingState) return;
-    const Rectangle swordRect = GetSwordAABB();
+    const Rectangle swordRect = GetSwordAABB(owner);
     if (swordRect.width <= 0 || swordRect.height <= 0) return;
 
-    for (auto it = birds.begin(); it != birds.end();)
+    std::vector<Archetype>& archetypes = entities.GetArchetypes();
+    for (size_t a = 0; a < archetypes.size(); ++a)
     {
-        // 检查剑的碰撞框与鸟的碰撞框是否相交
-        if (CheckCollisionRecs(swordRect, it->GetCollisionRect()))
+        Archetype& archetype = archetypes[a];
+        if (!archetype.Has(Component::SLASHABLE | Component::COLLIDER)) continue;
+        // 从后往前遍历，删除时移过来的最后一行已经检查过
+        for (size_t i = archetype.size(); i-- > 0;)
         {
-            PlaySound(birdScreamSound);
-            const Vector2 birdCenter = {
-                it->getPosition().x + it->GetWidth() / 2.0f,
-                it->getPosition().y + it->GetHeight() / 2.0f
-            };
+            // 检查剑的碰撞框与实体的碰撞框是否相交
+            const Rectangle& collider = archetype.colliders[i];
+            if (!CheckCollisionRecs(swordRect, collider)) continue;
+            AudioSystem::Play(birdScreamSound);
+            const Vector2 birdCenter = {collider.x + collider.width / 2.0f, collider.y + collider.height / 2.0f};
             // 血液粒子效果
-            effectParticles.Emit(birdCenter, GetRandomValue(25, 40), effectProps, worldScrollSpeed);
-            it = birds.erase(it);
-        }
-        else
-        {
-            ++it;
+            effectParticles.Emit(birdCenter, randI(25, 41), effectProps, worldScrollSpeed);
+            entities.Destroy(static_cast<ArchetypeId>(a), i);
         }
     }
 }
@@ -206,3 +206,21 @@ float Sword::GetCooldownProgress() const
     }
     return cooldownTimer / attackCooldown;
 }
+
+// 将剑的攻击与冷却状态写入快照
+void Sword::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(cooldownTimer);
+    writer.Write(isAttackingState);
+    writer.Write(attackTimer);
+    writer.Write(currentVisualRotation);
+}
+
+// 从快照恢复剑的状态
+void Sword::LoadState(SnapshotReader& reader)
+{
+    reader.Read(cooldownTimer);
+    reader.Read(isAttackingState);
+    reader.Read(attackTimer);
+    reader.Read(currentVisualRotation);
+}
@@ -0,0 +1,127 @@
+// src/TextLayoutCache.cpp
+#include "../include/TextLayoutCache.h"
+#include <functional>
+
+std::mutex TextLayoutCache::mutex;
+std::unordered_map<TextLayoutCache::Key, TextLayout, TextLayoutCache::KeyHash> TextLayoutCache::layouts;
+std::unordered_map<unsigned int, TextureHandle> TextLayoutCache::fontTextures;
+
+namespace
+{
+    constexpr int DEFAULT_FONT_SIZE = 10; // DrawText 使用的默认字体基准字号
+    constexpr float LINE_SPACING = 2.0f; // raylib 默认行距 (本游戏不修改)
+
+    // 与 DrawText 相同的字号与字距换算
+    void DefaultFontParams(const int fontSize, float& size, float& spacing)
+    {
+        const int clampedSize = fontSize < DEFAULT_FONT_SIZE ? DEFAULT_FONT_SIZE : fontSize;
+        size = static_cast<float>(clampedSize);
+        spacing = static_cast<float>(clampedSize / DEFAULT_FONT_SIZE);
+    }
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<std::string>()(key.text);
+    hash ^= std::hash<unsigned int>()(key.fontTextureId) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.fontSize) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.spacing) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// 登记字体纹理
+void TextLayoutCache::RegisterFont(const Font& font)
+{
+    const std::lock_guard lock(mutex);
+    if (font.texture.id == 0 || fontTextures.contains(font.texture.id)) return;
+    fontTextures[font.texture.id] = TextureLibrary::Register(font.texture);
+}
+
+// 生成文字排版：字形位置与 DrawTextEx 逐字绘制时完全一致
+void TextLayoutCache::Build(const std::string& text, const Font& font, const float fontSize, const float spacing,
+                            TextLayout& layout)
+{
+    layout.glyphs.clear();
+    layout.size = {0, 0};
+    {
+        const std::lock_guard lock(mutex);
+        const auto it = fontTextures.find(font.texture.id);
+        layout.fontTexture = it != fontTextures.end() ? it->second : INVALID_TEXTURE;
+    }
+    if (text.empty() || font.glyphs == nullptr || font.baseSize <= 0) return;
+
+    layout.size = MeasureTextEx(font, text.c_str(), fontSize, spacing);
+    const float scaleFactor = fontSize / static_cast<float>(font.baseSize);
+    const auto padding = static_cast<float>(font.glyphPadding);
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    for (size_t i = 0; i < text.size();)
+    {
+        int codepointByteCount = 0;
+        const int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        const int index = GetGlyphIndex(font, codepoint);
+        i += codepointByteCount > 0 ? codepointByteCount : 1;
+
+        if (codepoint == '\n')
+        {
+            offsetY += fontSize + LINE_SPACING;
+            offsetX = 0.0f;
+            continue;
+        }
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+        if (codepoint != ' ' && codepoint != '\t')
+        {
+            GlyphQuad quad;
+            quad.source = {rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding};
+            quad.dest = {
+                offsetX + (static_cast<float>(glyph.offsetX) - padding) * scaleFactor,
+                offsetY + (static_cast<float>(glyph.offsetY) - padding) * scaleFactor,
+                quad.source.width * scaleFactor,
+                quad.source.height * scaleFactor
+            };
+            layout.glyphs.push_back(quad);
+        }
+        offsetX += (glyph.advanceX == 0 ? rec.width : static_cast<float>(glyph.advanceX)) * scaleFactor + spacing;
+    }
+}
+
+// 按 DrawText 的参数生成默认字体的文字排版而不缓存
+void TextLayoutCache::BuildDefault(const std::string& text, const int fontSize, TextLayout& layout)
+{
+    float size, spacing;
+    DefaultFontParams(fontSize, size, spacing);
+    Build(text, GetFontDefault(), size, spacing, layout);
+}
+
+// 获取文字排版
+const TextLayout& TextLayoutCache::Get(const std::string& text, const Font& font, const float fontSize,
+                                       const float spacing)
+{
+    Key key{text, font.texture.id, fontSize, spacing};
+    {
+        const std::lock_guard lock(mutex);
+        if (const auto it = layouts.find(key); it != layouts.end()) return it->second;
+    }
+    // 在锁外测量，避免阻塞另一个线程；同时生成同一段文字时只保留先插入的结果
+    TextLayout layout;
+    Build(text, font, fontSize, spacing, layout);
+    const std::lock_guard lock(mutex);
+    return layouts.try_emplace(std::move(key), std::move(layout)).first->second;
+}
+
+// 按 DrawText/MeasureText 的参数获取默认字体的文字排版
+const TextLayout& TextLayoutCache::GetDefault(const std::string& text, const int fontSize)
+{
+    float size, spacing;
+    DefaultFontParams(fontSize, size, spacing);
+    return Get(text, GetFontDefault(), size, spacing);
+}
+
+// 清空缓存与登记的字体
+void TextLayoutCache::Clear()
+{
+    const std::lock_guard lock(mutex);
+    layouts.clear();
+    fontTextures.clear();
+}
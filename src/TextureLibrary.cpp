@@ -0,0 +1,89 @@
+// src/TextureLibrary.cpp
+#include "../include/TextureLibrary.h"
+
+std::vector<Texture2D> TextureLibrary::textures;
+std::vector<bool> TextureLibrary::owned;
+std::vector<std::string> TextureLibrary::paths;
+
+TextureHandle TextureLibrary::Load(const char* path)
+{
+    Texture2D tempTex = LoadTexture(path);
+    if (tempTex.id > 0)
+    {
+        SetTextureFilter(tempTex, TEXTURE_FILTER_POINT);
+    }
+    textures.push_back(tempTex);
+    owned.push_back(true);
+    paths.emplace_back(path);
+    return static_cast<TextureHandle>(textures.size()) - 1;
+}
+
+TextureHandle TextureLibrary::LoadFromImage(const Image& image)
+{
+    Texture2D tempTex = LoadTextureFromImage(image);
+    if (tempTex.id > 0)
+    {
+        SetTextureFilter(tempTex, TEXTURE_FILTER_POINT);
+    }
+    textures.push_back(tempTex);
+    owned.push_back(true);
+    paths.emplace_back();
+    return static_cast<TextureHandle>(textures.size()) - 1;
+}
+
+TextureHandle TextureLibrary::Register(const Texture2D& texture)
+{
+    textures.push_back(texture);
+    owned.push_back(false);
+    paths.emplace_back();
+    return static_cast<TextureHandle>(textures.size()) - 1;
+}
+
+TextureGroup TextureLibrary::LoadGroup(const std::vector<std::string>& paths)
+{
+    TextureGroup group;
+    group.first = static_cast<TextureHandle>(textures.size());
+    for (const auto& path : paths)
+    {
+        Load(path.c_str());
+    }
+    group.count = static_cast<int>(paths.size());
+    return group;
+}
+
+const Texture2D& TextureLibrary::Get(const TextureHandle handle)
+{
+    static constexpr Texture2D emptyTexture{};
+    if (handle < 0 || handle >= static_cast<TextureHandle>(textures.size()))
+    {
+        return emptyTexture;
+    }
+    return textures[handle];
+}
+
+void TextureLibrary::UnloadAll()
+{
+    for (size_t i = 0; i < textures.size(); ++i)
+    {
+        if (owned[i] && textures[i].id > 0) UnloadTexture(textures[i]);
+    }
+    textures.clear();
+    owned.clear();
+    paths.clear();
+}
+
+int TextureLibrary::Reload(const std::string& path, const Image& image)
+{
+    int replaced = 0;
+    for (size_t i = 0; i < textures.size(); ++i)
+    {
+        if (paths[i] != path) continue;
+        Texture2D newTex = LoadTextureFromImage(image);
+        if (newTex.id == 0) continue;
+        SetTextureFilter(newTex, TEXTURE_FILTER_POINT);
+        if (textures[i].id > 0) UnloadTexture(textures[i]);
+        textures[i] = newTex;
+        ++replaced;
+    }
+    return replaced;
+}
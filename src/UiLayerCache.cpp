@@ -0,0 +1,109 @@
+// src/UiLayerCache.cpp
+#include "../include/UiLayerCache.h"
+
+// 按虚拟屏幕尺寸计算布局
+MenuLayout MenuLayout::Compute(const int virtualWidth, const int virtualHeight)
+{
+    MenuLayout layout;
+    layout.titleX = virtualWidth / 2 - MeasureText(layout.title, layout.titleFontSize) / 2;
+    layout.titleY = static_cast<int>(virtualHeight * 0.2f);
+
+    constexpr float buttonWidth = 220;
+    constexpr float buttonHeight = 50;
+    constexpr float buttonSpacing = 20;
+    const char* buttonTexts[] = {"Restart Game", "Quit Game"};
+    float buttonY = virtualHeight * 0.45f;
+    for (size_t i = 0; i < layout.buttons.size(); ++i)
+    {
+        MenuButtonLayout& button = layout.buttons[i];
+        button.rect = {virtualWidth / 2.0f - buttonWidth / 2.0f, buttonY, buttonWidth, buttonHeight};
+        button.text = buttonTexts[i];
+        const int textWidth = MeasureText(button.text, layout.buttonFontSize);
+        button.textX = static_cast<int>(button.rect.x + (buttonWidth - textWidth) / 2);
+        button.textY = static_cast<int>(button.rect.y + (buttonHeight - layout.buttonFontSize) / 2);
+        buttonY += buttonHeight + buttonSpacing;
+    }
+
+    layout.gameOverX = virtualWidth / 2 - MeasureText(layout.gameOverText, layout.gameOverFontSize) / 2;
+    layout.gameOverY = static_cast<int>(virtualHeight * 0.4f);
+    layout.restartHintX = virtualWidth / 2 - MeasureText(layout.restartHintText, layout.restartHintFontSize) / 2;
+    layout.restartHintY = static_cast<int>(virtualHeight * 0.6f);
+    return layout;
+}
+
+// 返回虚拟屏幕坐标下的按钮
+MenuButton MenuLayout::HitTest(const Vector2 virtualPos) const
+{
+    for (size_t i = 0; i < buttons.size(); ++i)
+    {
+        if (CheckCollisionPointRec(virtualPos, buttons[i].rect)) return static_cast<MenuButton>(i);
+    }
+    return MenuButton::NONE;
+}
+
+UiLayerCache::UiLayerCache()
+    : pauseLayer{}, gameOverLayer{}, pauseHandle(INVALID_TEXTURE), gameOverHandle(INVALID_TEXTURE),
+      cachedHover(MenuButton::NONE), pauseLayerValid(false), pauseRedrawCount(0)
+{
+}
+
+// 创建渲染纹理并渲染游戏结束界面
+void UiLayerCache::Initialize(const MenuLayout& menuLayout, const int virtualWidth, const int virtualHeight)
+{
+    Unload();
+    layout = menuLayout;
+    pauseLayer = LoadRenderTexture(virtualWidth, virtualHeight);
+    gameOverLayer = LoadRenderTexture(virtualWidth, virtualHeight);
+    SetTextureFilter(pauseLayer.texture, TEXTURE_FILTER_POINT);
+    SetTextureFilter(gameOverLayer.texture, TEXTURE_FILTER_POINT);
+    pauseHandle = TextureLibrary::Register(pauseLayer.texture);
+    gameOverHandle = TextureLibrary::Register(gameOverLayer.texture);
+
+    // 游戏结束界面没有可交互的内容，渲染一次即可
+    BeginTextureMode(gameOverLayer);
+    ClearBackground(BLANK);
+    DrawText(layout.gameOverText, layout.gameOverX, layout.gameOverY, layout.gameOverFontSize, RED);
+    DrawText(layout.restartHintText, layout.restartHintX, layout.restartHintY, layout.restartHintFontSize, DARKGRAY);
+    EndTextureMode();
+    pauseLayerValid = false;
+}
+
+// 释放渲染纹理
+void UiLayerCache::Unload()
+{
+    if (pauseLayer.id > 0) UnloadRenderTexture(pauseLayer);
+    if (gameOverLayer.id > 0) UnloadRenderTexture(gameOverLayer);
+    pauseLayer = {};
+    gameOverLayer = {};
+    pauseLayerValid = false;
+}
+
+// 悬停按钮改变时重绘暂停界面
+// 遮罩不放进缓存：半透明像素画进透明纹理后透明度会被平方，所以缓存里只有不透明的标题与按钮
+void UiLayerCache::UpdatePauseLayer(const MenuButton hovered)
+{
+    if (pauseLayer.id == 0 || (pauseLayerValid && hovered == cachedHover)) return;
+
+    BeginTextureMode(pauseLayer);
+    ClearBackground(BLANK);
+    DrawText(layout.title, layout.titleX, layout.titleY, layout.titleFontSize, WHITE);
+    for (size_t i = 0; i < layout.buttons.size(); ++i)
+    {
+        const MenuButtonLayout& button = layout.buttons[i];
+        const Color buttonColor = hovered == static_cast<MenuButton>(i) ? GRAY : DARKGRAY; // 鼠标悬停时变色
+        DrawRectangleRec(button.rect, buttonColor); // 按钮背景
+        DrawRectangleLinesEx(button.rect, 2, LIGHTGRAY); // 按钮边框
+        DrawText(button.text, button.textX, button.textY, layout.buttonFontSize, WHITE);
+    }
+    EndTextureMode();
+
+    cachedHover = hovered;
+    pauseLayerValid = true;
+    ++pauseRedrawCount;
+}
+
+// 缓存纹理的源矩形
+Rectangle UiLayerCache::GetSourceRect() const
+{
+    return {0.0f, 0.0f, static_cast<float>(pauseLayer.texture.width), -static_cast<float>(pauseLayer.texture.height)};
+}
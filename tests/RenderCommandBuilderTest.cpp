@@ -0,0 +1,62 @@
+// tests/RenderCommandBuilderTest.cpp
+// 不创建窗口，用手工构造的世界快照检查命令列表的绘制调用数与剔除数
+#include "../include/RenderCommandBuilder.h"
+#include <iostream>
+
+namespace
+{
+    constexpr float SPRITE_SIZE = 64.0f; // 假纹理的边长
+
+    // 假纹理尺寸：所有纹理都是 SPRITE_SIZE 见方，不需要加载纹理
+    Vector2 FakeTextureSize(TextureHandle)
+    {
+        return {SPRITE_SIZE, SPRITE_SIZE};
+    }
+
+    // 假文字排版：返回空排版，不需要字体
+    const TextLayout& FakeLayoutText(const std::string&, int)
+    {
+        static const TextLayout empty{};
+        return empty;
+    }
+
+    // 检查一个计数，不符时打印期望值与实际值
+    bool Expect(const char* name, const int actual, const int expected)
+    {
+        if (actual == expected) return true;
+        std::cerr << name << ": expected " << expected << ", got " << actual << '\n';
+        return false;
+    }
+}
+
+int main()
+{
+    RenderSnapshot frame;
+    frame.state = GameState::PLAYING;
+
+    // 一个只有位置和纹理帧的原型，一个实体在屏幕内，一个完全在屏幕左侧外
+    const ArchetypeId sprites = frame.entities.RegisterArchetype(Component::POSITION | Component::SPRITE);
+    EntityDesc onScreen;
+    onScreen.position = {400.0f, 300.0f};
+    onScreen.frames = {0, 1};
+    frame.entities.Create(sprites, onScreen);
+    EntityDesc offScreen = onScreen;
+    offScreen.position = {-500.0f, 300.0f};
+    frame.entities.Create(sprites, offScreen);
+
+    RenderInputs inputs;
+    inputs.resources.textureSize = FakeTextureSize;
+    inputs.resources.layoutText = FakeLayoutText;
+
+    RenderCommandList commands;
+    RenderCommandBuilder::Build(frame, inputs, commands);
+
+    const RenderListStats stats = commands.GetStats();
+    bool passed = Expect("commandCount", stats.commandCount, 1);
+    passed = Expect("culledCount", stats.culledCount, 1) && passed;
+    if (!passed) return 1;
+
+    std::cout << "RenderCommandBuilder: " << stats.commandCount << " command(s), "
+        << stats.culledCount << " culled\n";
+    return 0;
+}